@@ -87,11 +87,9 @@ void printEntries(Entries::Ptr entries)
     for (size_t i = 0; i < entries->size(); ++i)
     {
         cout << "***************" << i << "***************" << endl;
-        auto data = entries->get(i)->fields();
-        for (auto& it : *data)
-        {
-            cout << "[ " << it.first << " ]:[ " << it.second << " ]" << endl;
-        }
+        entries->get(i)->forEachField([](const string& name, const string& value) {
+            cout << "[ " << name << " ]:[ " << value << " ]" << endl;
+        });
     }
     cout << "============================" << endl;
 }
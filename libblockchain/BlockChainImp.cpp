@@ -48,9 +48,18 @@ using namespace dev::executive;
 using boost::lexical_cast;
 
 
+BlockChainImp::~BlockChainImp()
+{
+    if (m_stateStorage)
+    {
+        m_stateStorage->setPersistHandler(nullptr);
+    }
+}
+
 void BlockChainImp::setStateStorage(Storage::Ptr stateStorage)
 {
     m_stateStorage = stateStorage;
+    m_stateStorage->setPersistHandler([this](int64_t _num) { m_onDurable(_num); });
 }
 
 void BlockChainImp::setStateFactory(StateFactoryInterface::Ptr _stateFactory)
@@ -83,6 +92,17 @@ int64_t BlockChainImp::number()
     return num;
 }
 
+int64_t BlockChainImp::durableNumber()
+{
+    int64_t num = number();
+    int64_t pendingNumber = m_stateStorage->pendingNumber();
+    if (pendingNumber >= 0 && pendingNumber <= num)
+    {
+        return pendingNumber - 1;
+    }
+    return num;
+}
+
 std::pair<int64_t, int64_t> BlockChainImp::totalTransactionCount()
 {
     int64_t count = 0;
@@ -143,7 +163,98 @@ h256 BlockChainImp::numberHash(int64_t _i)
 
 std::shared_ptr<Block> BlockChainImp::getBlockByHash(h256 const& _blockHash)
 {
-    string strblock = "";
+    auto block = getCachedBlock(_blockHash);
+    if (block)
+    {
+        return block;
+    }
+    auto blockData = getBlockData(_blockHash);
+    if (blockData)
+    {
+        /// the stored blocks have been verified when they were committed
+        block = std::make_shared<Block>(*blockData, CheckTransaction::None);
+        auto nonces = readBlockNonces(block->blockHeader().number());
+        if (nonces && nonces->size() == block->transactions().size())
+        {
+            std::vector<Address> senders;
+            senders.reserve(nonces->size());
+            for (auto const& item : *nonces)
+            {
+                senders.push_back(item.first);
+            }
+            block->setSenders(senders);
+        }
+        else
+        {
+            /// the cached block is shared, recover the senders before handing it out
+            for (auto const& tx : block->transactions())
+            {
+                tx.safeSender();
+            }
+        }
+        cacheBlock(block);
+        return block;
+    }
+    BLOCKCHAIN_LOG(TRACE) << "[#getBlockByHash] Can't find block, return nullptr";
+    return nullptr;
+}
+
+std::shared_ptr<Block> BlockChainImp::getCachedBlock(h256 const& _blockHash)
+{
+    {
+        ReadGuard l(m_blockCacheMutex);
+        auto it = m_blockHashCache.find(_blockHash);
+        if (it != m_blockHashCache.end())
+        {
+            ++m_blockCacheHit;
+            return m_blockCache.find(it->second)->second;
+        }
+    }
+    ++m_blockCacheMiss;
+    return nullptr;
+}
+
+void BlockChainImp::cacheBlock(std::shared_ptr<Block> _block)
+{
+    if (m_blockCacheLimit == 0)
+    {
+        return;
+    }
+    /// the const Transaction::sha3 memoizes the hash, compute it before the block is shared
+    for (auto const& tx : _block->transactions())
+    {
+        tx.sha3();
+    }
+    int64_t blockNumber = _block->blockHeader().number();
+    WriteGuard l(m_blockCacheMutex);
+    auto it = m_blockCache.find(blockNumber);
+    if (it != m_blockCache.end())
+    {
+        m_blockHashCache.erase(it->second->headerHash());
+    }
+    m_blockCache[blockNumber] = _block;
+    m_blockHashCache[_block->headerHash()] = blockNumber;
+    /// keep the highest numbers
+    while (m_blockCache.size() > m_blockCacheLimit)
+    {
+        auto lowest = m_blockCache.begin();
+        m_blockHashCache.erase(lowest->second->headerHash());
+        m_blockCache.erase(lowest);
+    }
+}
+
+BlockChainImp::BlockCacheStats BlockChainImp::blockCacheStats() const
+{
+    BlockCacheStats stats;
+    stats.hit = m_blockCacheHit.load();
+    stats.miss = m_blockCacheMiss.load();
+    ReadGuard l(m_blockCacheMutex);
+    stats.size = m_blockCache.size();
+    return stats;
+}
+
+std::shared_ptr<bytes> BlockChainImp::getBlockData(h256 const& _blockHash)
+{
     Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_HASH_2_BLOCK, false);
     if (tb)
     {
@@ -151,14 +262,35 @@ std::shared_ptr<Block> BlockChainImp::getBlockByHash(h256 const& _blockHash)
         if (entries->size() > 0)
         {
             auto entry = entries->get(0);
-            strblock = entry->getField(SYS_VALUE);
-            return std::make_shared<Block>(fromHex(strblock.c_str()));
+            string strblock = entry->getField(SYS_VALUE);
+            /// the blocks written before the binary format are hex encoded
+            if (strblock.compare(0, 2, "0x") == 0)
+            {
+                return std::make_shared<bytes>(fromHex(strblock));
+            }
+            return std::make_shared<bytes>(strblock.begin(), strblock.end());
         }
     }
-    BLOCKCHAIN_LOG(TRACE) << "[#getBlockByHash] Can't find block, return nullptr";
     return nullptr;
 }
 
+bool BlockChainImp::getTxIndex(h256 const& _txHash, int64_t& _blockNumber, unsigned& _txIndex)
+{
+    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
+    if (tb)
+    {
+        auto entries = tb->select(_txHash.hex(), tb->newCondition());
+        if (entries->size() > 0)
+        {
+            auto entry = entries->get(0);
+            _blockNumber = lexical_cast<int64_t>(entry->getField(SYS_VALUE));
+            _txIndex = lexical_cast<unsigned>(entry->getField("index"));
+            return true;
+        }
+    }
+    return false;
+}
+
 bool BlockChainImp::checkAndBuildGenesisBlock(GenesisBlockParam& initParam)
 {
     std::shared_ptr<Block> block = getBlockByNumber(0);
@@ -224,7 +356,7 @@ bool BlockChainImp::checkAndBuildGenesisBlock(GenesisBlockParam& initParam)
             Entry::Ptr entry = std::make_shared<Entry>();
             bytes out;
             block->encode(out);
-            entry->setField(SYS_VALUE, toHexPrefixed(out));
+            entry->setField(SYS_VALUE, std::string(out.begin(), out.end()));
             tb->insert(block->blockHeader().hash().hex(), entry);
         }
 
@@ -256,10 +388,14 @@ bool BlockChainImp::checkAndBuildGenesisBlock(GenesisBlockParam& initParam)
             try
             {
                 boost::split(s, extraData, boost::is_any_of("-"), boost::token_compress_on);
-                assert(s.size() == 7);
+                assert(s.size() >= 7);
                 initParam.consensusType = s[2];
                 initParam.storageType = s[3];
                 initParam.stateType = s[4];
+                if (s.size() > 7)
+                {
+                    initParam.markOptions.assign(s.begin() + 7, s.end());
+                }
             }
             catch (std::exception& e)
             {
@@ -426,6 +562,15 @@ std::string BlockChainImp::getSystemConfigByKey(std::string const& key, int64_t
 
 std::shared_ptr<Block> BlockChainImp::getBlockByNumber(int64_t _i)
 {
+    {
+        ReadGuard l(m_blockCacheMutex);
+        auto it = m_blockCache.find(_i);
+        if (it != m_blockCache.end())
+        {
+            ++m_blockCacheHit;
+            return it->second;
+        }
+    }
     string numberHash = "";
     string strblock = "";
     Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_NUMBER_2_HASH, false);
@@ -443,24 +588,84 @@ std::shared_ptr<Block> BlockChainImp::getBlockByNumber(int64_t _i)
     return nullptr;
 }
 
-Transaction BlockChainImp::getTxByHash(dev::h256 const& _txHash)
+std::shared_ptr<BlockNonces> BlockChainImp::getBlockNonces(int64_t _i)
 {
-    string strblock = "";
-    string txIndex = "";
-    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
+    auto nonces = readBlockNonces(_i);
+    if (nonces)
+    {
+        return nonces;
+    }
+    /// the blocks committed before the nonce index existed
+    BLOCKCHAIN_LOG(TRACE) << "[#getBlockNonces] Can't find nonces, read the block [number]: "
+                          << _i;
+    return BlockChainInterface::getBlockNonces(_i);
+}
+
+std::shared_ptr<bytes> BlockChainImp::getBlockNoncesData(int64_t _i)
+{
+    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_BLOCK_2_NONCES, false);
     if (tb)
     {
-        auto entries = tb->select(_txHash.hex(), tb->newCondition());
+        auto entries = tb->select(lexical_cast<std::string>(_i), tb->newCondition());
         if (entries->size() > 0)
         {
             auto entry = entries->get(0);
-            strblock = entry->getField(SYS_VALUE);
-            txIndex = entry->getField("index");
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(strblock));
-            std::vector<Transaction> txs = pblock->transactions();
-            if (txs.size() > lexical_cast<uint>(txIndex))
+            string data = entry->getField(SYS_VALUE);
+            return std::make_shared<bytes>(data.begin(), data.end());
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<BlockNonces> BlockChainImp::readBlockNonces(int64_t _i)
+{
+    auto data = getBlockNoncesData(_i);
+    if (data)
+    {
+        auto nonces = std::make_shared<BlockNonces>();
+        for (auto const& item : RLP(*data))
+        {
+            nonces->emplace_back(item[0].toHash<Address>(), item[1].toInt<u256>());
+        }
+        return nonces;
+    }
+    return nullptr;
+}
+
+/// the senders are taken from the nonce index when it exists, or recovered when they are read
+void BlockChainImp::decodeStoredTx(
+    Transaction& _tx, RLP const& _txRLP, int64_t _blockNumber, unsigned _txIndex)
+{
+    _tx.decode(_txRLP, CheckTransaction::None);
+    auto data = getBlockNoncesData(_blockNumber);
+    if (data)
+    {
+        /// only the sender of this transaction is decoded, not the nonces of the whole block
+        RLP nonces(*data);
+        if (nonces.isList() && nonces.itemCount() > _txIndex)
+        {
+            _tx.forceSender(nonces[_txIndex][0].toHash<Address>());
+        }
+    }
+}
+
+/// the transactions and receipts are located in the encoded block, only the requested one is
+/// decoded
+Transaction BlockChainImp::getTxByHash(dev::h256 const& _txHash)
+{
+    int64_t blockNumber = 0;
+    unsigned txIndex = 0;
+    if (getTxIndex(_txHash, blockNumber, txIndex))
+    {
+        auto blockData = getBlockData(numberHash(blockNumber));
+        if (blockData)
+        {
+            RLP txsRLP = BlockHeader::extractBlock(ref(*blockData))[1];
+            if (txsRLP.itemCount() > txIndex)
             {
-                return txs[lexical_cast<uint>(txIndex)];
+                Transaction tx;
+                decodeStoredTx(tx, txsRLP[txIndex], blockNumber, txIndex);
+                return tx;
             }
         }
     }
@@ -470,23 +675,20 @@ Transaction BlockChainImp::getTxByHash(dev::h256 const& _txHash)
 
 LocalisedTransaction BlockChainImp::getLocalisedTxByHash(dev::h256 const& _txHash)
 {
-    string strblockhash = "";
-    string txIndex = "";
-    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
-    if (tb)
+    int64_t blockNumber = 0;
+    unsigned txIndex = 0;
+    if (getTxIndex(_txHash, blockNumber, txIndex))
     {
-        auto entries = tb->select(_txHash.hex(), tb->newCondition());
-        if (entries->size() > 0)
+        h256 blockHash = numberHash(blockNumber);
+        auto blockData = getBlockData(blockHash);
+        if (blockData)
         {
-            auto entry = entries->get(0);
-            strblockhash = entry->getField(SYS_VALUE);
-            txIndex = entry->getField("index");
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(strblockhash));
-            std::vector<Transaction> txs = pblock->transactions();
-            if (txs.size() > lexical_cast<uint>(txIndex))
+            RLP txsRLP = BlockHeader::extractBlock(ref(*blockData))[1];
+            if (txsRLP.itemCount() > txIndex)
             {
-                return LocalisedTransaction(txs[lexical_cast<uint>(txIndex)], pblock->headerHash(),
-                    lexical_cast<unsigned>(txIndex), pblock->blockHeader().number());
+                Transaction tx;
+                decodeStoredTx(tx, txsRLP[txIndex], blockNumber, txIndex);
+                return LocalisedTransaction(tx, blockHash, txIndex, blockNumber);
             }
         }
     }
@@ -496,22 +698,19 @@ LocalisedTransaction BlockChainImp::getLocalisedTxByHash(dev::h256 const& _txHas
 
 TransactionReceipt BlockChainImp::getTransactionReceiptByHash(dev::h256 const& _txHash)
 {
-    string strblock = "";
-    string txIndex = "";
-    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
-    if (tb)
+    int64_t blockNumber = 0;
+    unsigned txIndex = 0;
+    if (getTxIndex(_txHash, blockNumber, txIndex))
     {
-        auto entries = tb->select(_txHash.hex(), tb->newCondition());
-        if (entries->size() > 0)
+        auto blockData = getBlockData(numberHash(blockNumber));
+        if (blockData)
         {
-            auto entry = entries->get(0);
-            strblock = entry->getField(SYS_VALUE);
-            txIndex = entry->getField("index");
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(strblock));
-            std::vector<TransactionReceipt> receipts = pblock->transactionReceipts();
-            if (receipts.size() > lexical_cast<uint>(txIndex))
+            RLP receiptsRLP = BlockHeader::extractBlock(ref(*blockData))[2];
+            if (receiptsRLP.itemCount() > txIndex)
             {
-                return receipts[lexical_cast<uint>(txIndex)];
+                TransactionReceipt receipt;
+                receipt.decode(receiptsRLP[txIndex]);
+                return receipt;
             }
         }
     }
@@ -522,27 +721,26 @@ TransactionReceipt BlockChainImp::getTransactionReceiptByHash(dev::h256 const& _
 
 LocalisedTransactionReceipt BlockChainImp::getLocalisedTxReceiptByHash(dev::h256 const& _txHash)
 {
-    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_TX_HASH_2_BLOCK, false);
-    if (tb)
+    int64_t blockNumber = 0;
+    unsigned txIndex = 0;
+    if (getTxIndex(_txHash, blockNumber, txIndex))
     {
-        auto entries = tb->select(_txHash.hex(), tb->newCondition());
-        if (entries->size() > 0)
+        h256 blockHash = numberHash(blockNumber);
+        auto blockData = getBlockData(blockHash);
+        if (blockData)
         {
-            auto entry = entries->get(0);
-            auto blockNum = lexical_cast<int64_t>(entry->getField(SYS_VALUE));
-            auto txIndex = lexical_cast<uint>(entry->getField("index"));
-
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(blockNum));
-            const Transactions& txs = pblock->transactions();
-            const TransactionReceipts& receipts = pblock->transactionReceipts();
-            if (receipts.size() > txIndex && txs.size() > txIndex)
+            RLP blockRLP = BlockHeader::extractBlock(ref(*blockData));
+            RLP txsRLP = blockRLP[1];
+            RLP receiptsRLP = blockRLP[2];
+            if (receiptsRLP.itemCount() > txIndex && txsRLP.itemCount() > txIndex)
             {
-                auto& tx = txs[txIndex];
-                auto& receipt = receipts[txIndex];
+                Transaction tx;
+                decodeStoredTx(tx, txsRLP[txIndex], blockNumber, txIndex);
+                TransactionReceipt receipt;
+                receipt.decode(receiptsRLP[txIndex]);
 
-                return LocalisedTransactionReceipt(receipt, _txHash, pblock->headerHash(),
-                    pblock->header().number(), tx.from(), tx.to(), txIndex, receipt.gasUsed(),
-                    receipt.contractAddress());
+                return LocalisedTransactionReceipt(receipt, _txHash, blockHash, blockNumber,
+                    tx.from(), tx.to(), txIndex, receipt.gasUsed(), receipt.contractAddress());
             }
         }
     }
@@ -631,15 +829,34 @@ void BlockChainImp::writeHash2Block(Block& block, std::shared_ptr<ExecutiveConte
         Entry::Ptr entry = std::make_shared<Entry>();
         bytes out;
         block.encode(out);
-        entry->setField(SYS_VALUE, toHexPrefixed(out));
+        entry->setField(SYS_VALUE, std::string(out.begin(), out.end()));
         tb->insert(block.blockHeader().hash().hex(), entry);
     }
 }
 
+void BlockChainImp::writeBlockNonces(const Block& block, std::shared_ptr<ExecutiveContext> context)
+{
+    Table::Ptr tb = context->getMemoryTableFactory()->openTable(SYS_BLOCK_2_NONCES, false);
+    if (tb)
+    {
+        RLPStream s;
+        s.appendList(block.transactions().size());
+        for (auto const& tx : block.transactions())
+        {
+            s.appendList(2) << tx.from() << tx.nonce();
+        }
+        Entry::Ptr entry = std::make_shared<Entry>();
+        bytes const& out = s.out();
+        entry->setField(SYS_VALUE, std::string(out.begin(), out.end()));
+        tb->insert(lexical_cast<std::string>(block.blockHeader().number()), entry);
+    }
+}
+
 void BlockChainImp::writeBlockInfo(Block& block, std::shared_ptr<ExecutiveContext> context)
 {
     writeNumber2Hash(block, context);
     writeHash2Block(block, context);
+    writeBlockNonces(block, context);
 }
 
 CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveContext> context)
@@ -667,7 +884,12 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
         writeTxToBlock(block, context);
         writeBlockInfo(block, context);
         context->dbCommit(block);
+        cacheBlock(std::make_shared<Block>(block));
         commitMutex.unlock();
+        auto stats = blockCacheStats();
+        BLOCKCHAIN_LOG(DEBUG) << "[#commitBlock] block cache [number/hit/miss/size]: "
+                              << block.blockHeader().number() << "/" << stats.hit << "/"
+                              << stats.miss << "/" << stats.size;
         m_onReady();
         return CommitResult::OK;
     }
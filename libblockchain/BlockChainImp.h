@@ -32,7 +32,10 @@
 #include <libstorage/Storage.h>
 #include <libstorage/SystemConfigPrecompiled.h>
 #include <libstoragestate/StorageStateFactory.h>
+#include <atomic>
+#include <map>
 #include <memory>
+#include <unordered_map>
 
 #define BLOCKCHAIN_LOG(LEVEL) LOG(LEVEL) << "[#BLOCKCHAIN]"
 
@@ -52,9 +55,17 @@ namespace blockchain
 class BlockChainImp : public BlockChainInterface
 {
 public:
+    struct BlockCacheStats
+    {
+        uint64_t hit = 0;
+        uint64_t miss = 0;
+        uint64_t size = 0;
+    };
+
     BlockChainImp() {}
-    virtual ~BlockChainImp(){};
+    virtual ~BlockChainImp();
     int64_t number() override;
+    int64_t durableNumber() override;
     dev::h256 numberHash(int64_t _i) override;
     dev::eth::Transaction getTxByHash(dev::h256 const& _txHash) override;
     dev::eth::LocalisedTransaction getLocalisedTxByHash(dev::h256 const& _txHash) override;
@@ -63,6 +74,7 @@ public:
         dev::h256 const& _txHash) override;
     std::shared_ptr<dev::eth::Block> getBlockByHash(dev::h256 const& _blockHash) override;
     std::shared_ptr<dev::eth::Block> getBlockByNumber(int64_t _i) override;
+    std::shared_ptr<BlockNonces> getBlockNonces(int64_t _i) override;
     CommitResult commitBlock(dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context) override;
     virtual void setStateStorage(dev::storage::Storage::Ptr stateStorage);
@@ -76,7 +88,16 @@ public:
     dev::h512s observerList() override;
     std::string getSystemConfigByKey(std::string const& key, int64_t num = -1) override;
 
+    /// the decoded blocks with the highest numbers are kept in memory, filled by commitBlock and
+    /// by the reads; the cached blocks are shared by the callers, which must not modify them,
+    /// the hashes and senders the transactions memoize are computed before they are cached
+    void setBlockCacheLimit(size_t _limit) { m_blockCacheLimit = _limit; }
+    BlockCacheStats blockCacheStats() const;
+
 private:
+    std::shared_ptr<dev::eth::Block> getCachedBlock(dev::h256 const& _blockHash);
+    void cacheBlock(std::shared_ptr<dev::eth::Block> _block);
+
     void writeNumber(const dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     void writeTotalTransactionCount(const dev::eth::Block& block,
@@ -89,6 +110,19 @@ private:
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     void writeHash2Block(
         dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
+    /// the encoded block, raw binary
+    std::shared_ptr<dev::bytes> getBlockData(dev::h256 const& _blockHash);
+    /// locate the transaction by SYS_TX_HASH_2_BLOCK
+    bool getTxIndex(dev::h256 const& _txHash, int64_t& _blockNumber, unsigned& _txIndex);
+    void writeBlockNonces(const dev::eth::Block& block,
+        std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
+    /// the SYS_BLOCK_2_NONCES row of the block, raw binary, nullptr if it has none
+    std::shared_ptr<dev::bytes> getBlockNoncesData(int64_t _i);
+    /// the SYS_BLOCK_2_NONCES row of the block, nullptr if it has none
+    std::shared_ptr<BlockNonces> readBlockNonces(int64_t _i);
+    /// decode a transaction of a stored block without recovering its sender
+    void decodeStoredTx(dev::eth::Transaction& _tx, dev::RLP const& _txRLP, int64_t _blockNumber,
+        unsigned _txIndex);
     dev::storage::Storage::Ptr m_stateStorage;
     std::mutex commitMutex;
     const std::string c_genesisHash =
@@ -111,6 +145,14 @@ private:
     };
     std::map<std::string, SystemConfigRecord> m_systemConfigRecord;
     mutable SharedMutex m_systemConfigMutex;
+
+    /// number => decoded block
+    std::map<int64_t, std::shared_ptr<dev::eth::Block>> m_blockCache;
+    std::unordered_map<dev::h256, int64_t> m_blockHashCache;
+    size_t m_blockCacheLimit = 10;
+    mutable SharedMutex m_blockCacheMutex;
+    std::atomic<uint64_t> m_blockCacheHit = {0};
+    std::atomic<uint64_t> m_blockCacheMiss = {0};
 };
 }  // namespace blockchain
 }  // namespace dev
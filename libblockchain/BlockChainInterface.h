@@ -54,13 +54,20 @@ struct GenesisBlockParam
     std::string stateType;      // the type of state, now mpt/storage
     uint64_t txCountLimit;      // the maximum number of transactions recorded in a block
     uint64_t txGasLimit;        // the maximum gas required to execute a transaction
+    std::vector<std::string> markOptions;  // options marked after txGasLimit, "name:value"
 };
+/// (sender, nonce) of the transactions of a block
+using BlockNonces = std::vector<std::pair<dev::Address, dev::u256>>;
+
 class BlockChainInterface
 {
 public:
     BlockChainInterface() = default;
     virtual ~BlockChainInterface(){};
     virtual int64_t number() = 0;
+    /// the highest block which has been persisted, may lag number() by the blocks
+    /// which are still being written in the background
+    virtual int64_t durableNumber() { return number(); }
     virtual dev::h256 numberHash(int64_t _i) = 0;
     virtual dev::eth::Transaction getTxByHash(dev::h256 const& _txHash) = 0;
     virtual dev::eth::LocalisedTransaction getLocalisedTxByHash(dev::h256 const& _txHash) = 0;
@@ -69,6 +76,18 @@ public:
         dev::h256 const& _txHash) = 0;
     virtual std::shared_ptr<dev::eth::Block> getBlockByHash(dev::h256 const& _blockHash) = 0;
     virtual std::shared_ptr<dev::eth::Block> getBlockByNumber(int64_t _i) = 0;
+    /// the nonces used by the block, for the nonce check of the txpool
+    virtual std::shared_ptr<BlockNonces> getBlockNonces(int64_t _i)
+    {
+        auto nonces = std::make_shared<BlockNonces>();
+        auto block = getBlockByNumber(_i);
+        if (block)
+        {
+            for (auto const& tx : block->transactions())
+                nonces->emplace_back(tx.from(), tx.nonce());
+        }
+        return nonces;
+    }
     virtual CommitResult commitBlock(
         dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext>) = 0;
     virtual std::pair<int64_t, int64_t> totalTransactionCount() = 0;
@@ -92,10 +111,19 @@ public:
         return m_onReady.add(_t);
     }
 
+    /// Register a handler that will be called with the number of a block once durableNumber()
+    /// moved past it, only for the blocks which were persisted after commitBlock returned
+    template <class T>
+    dev::eth::Handler<int64_t> onDurable(T const& _t)
+    {
+        return m_onDurable.add(_t);
+    }
+
 protected:
     ///< Called when a subsequent call to import transactions will return a non-empty container. Be
     ///< nice and exit fast.
     dev::eth::Signal<> m_onReady;
+    dev::eth::Signal<int64_t> m_onDurable;
 };
 }  // namespace blockchain
 }  // namespace dev
@@ -25,7 +25,10 @@
 #include <libethcore/TransactionReceipt.h>
 #include <libexecutive/ExecutionResult.h>
 #include <libexecutive/Executive.h>
+#include <condition_variable>
 #include <exception>
+#include <mutex>
+#include <set>
 using namespace dev;
 using namespace std;
 using namespace dev::eth;
@@ -54,21 +57,31 @@ ExecutiveContext::Ptr BlockVerifier::executeBlock(Block& block, BlockInfo const&
                               << errinfo_comment("Error during initExecutiveContext"));
     }
 
+    prefetch(block, executiveContext);
+
     unsigned i = 0;
     BlockHeader tmpHeader = block.blockHeader();
     block.clearAllReceipts();
-    for (Transaction const& tr : block.transactions())
-    {
-        EnvInfo envInfo(block.blockHeader(), m_pNumberHash,
-            block.getTransactionReceipts().size() > 0 ?
-                block.getTransactionReceipts().back().gasUsed() :
-                0);
-        envInfo.setPrecompiledEngine(executiveContext);
-        std::pair<ExecutionResult, TransactionReceipt> resultReceipt =
-            execute(envInfo, tr, OnOpFunc(), executiveContext);
-        block.appendTransactionReceipt(resultReceipt.second);
-        executiveContext->getState()->commit();
+    if (m_executePool && block.transactions().size() > 1)
+    {
+        executeParallel(block, parentBlockInfo, executiveContext);
+    }
+    else
+    {
+        for (Transaction const& tr : block.transactions())
+        {
+            EnvInfo envInfo(block.blockHeader(), m_pNumberHash,
+                block.getTransactionReceipts().size() > 0 ?
+                    block.getTransactionReceipts().back().gasUsed() :
+                    0);
+            envInfo.setPrecompiledEngine(executiveContext);
+            std::pair<ExecutionResult, TransactionReceipt> resultReceipt =
+                execute(envInfo, tr, OnOpFunc(), executiveContext);
+            block.appendTransactionReceipt(resultReceipt.second);
+            commitTransaction(executiveContext);
+        }
     }
+    executiveContext->getState()->commit();
     block.calReceiptRoot();
     block.header().setStateRoot(executiveContext->getState()->rootHash());
     if (tmpHeader.receiptsRoot() != h256() && tmpHeader.stateRoot() != h256())
@@ -82,15 +95,248 @@ ExecutiveContext::Ptr BlockVerifier::executeBlock(Block& block, BlockInfo const&
     return executiveContext;
 }
 
+void BlockVerifier::prefetch(Block const& block, ExecutiveContext::Ptr executiveContext)
+{
+    try
+    {
+        std::set<Address> addresses;
+        for (auto const& tx : block.transactions())
+        {
+            addresses.insert(tx.sender());
+            if (!tx.isCreation())
+            {
+                addresses.insert(tx.receiveAddress());
+            }
+        }
+        if (!addresses.empty())
+        {
+            executiveContext->getState()->prefetch(
+                std::vector<Address>(addresses.begin(), addresses.end()));
+        }
+    }
+    catch (exception& e)
+    {
+        // a bad signature fails the transaction during the execution, which also reads the
+        // rows that are missing
+        BLOCKVERIFIER_LOG(WARNING) << "[#executeBlock] prefetch failed [errorMsg]: "
+                                   << boost::diagnostic_information(e);
+    }
+}
+
+void BlockVerifier::setParallelThreads(size_t _threadNum)
+{
+    if (_threadNum > 0)
+    {
+        m_executePool = std::make_shared<dev::ThreadPool>("Execute", _threadNum);
+    }
+    else
+    {
+        m_executePool = nullptr;
+    }
+}
+
+/// Every transaction is first executed speculatively on its own context on top
+/// of the parent state, recording the rows it reads and writes in its
+/// MemoryTableFactory. The results are then validated in block order: a
+/// transaction that read a row written by an earlier transaction of the block
+/// is executed again on the block context, otherwise its rows are merged into
+/// the block context. Receipts and state root are the same as serial execution.
+void BlockVerifier::executeParallel(
+    Block& block, BlockInfo const& parentBlockInfo, ExecutiveContext::Ptr executiveContext)
+{
+    auto const& transactions = block.transactions();
+    std::vector<Speculation> speculations(transactions.size());
+    std::vector<size_t> indexes;
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        speculations[i].addressCount = executiveContext->addressCount();
+        indexes.push_back(i);
+    }
+    runParallel(indexes, [&](size_t index) {
+        speculate(block, parentBlockInfo, index, speculations[index]);
+    });
+
+    // opening a table registers a precompiled at the next free address, which the
+    // contract can observe. Execute such transactions again starting from the
+    // address the previous transactions of the block leave behind
+    indexes.clear();
+    int addressCount = executiveContext->addressCount();
+    for (size_t i = 0; i < speculations.size(); ++i)
+    {
+        auto& speculation = speculations[i];
+        if (!speculation.context)
+        {
+            continue;
+        }
+        int registered = speculation.context->addressCount() - speculation.addressCount;
+        if (registered > 0 && speculation.addressCount != addressCount)
+        {
+            speculation.addressCount = addressCount;
+            indexes.push_back(i);
+        }
+        addressCount += registered;
+    }
+    if (!indexes.empty())
+    {
+        runParallel(indexes, [&](size_t index) {
+            speculate(block, parentBlockInfo, index, speculations[index]);
+        });
+    }
+
+    auto memoryTableFactory = executiveContext->getMemoryTableFactory();
+    size_t reexecuted = 0;
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        auto& speculation = speculations[i];
+        u256 gasUsed = block.getTransactionReceipts().size() > 0 ?
+                           block.getTransactionReceipts().back().gasUsed() :
+                           0;
+        bool valid = speculation.context &&
+                     (speculation.context->addressCount() == speculation.addressCount ||
+                         speculation.addressCount == executiveContext->addressCount()) &&
+                     !memoryTableFactory->conflicts(
+                         *(speculation.context->getMemoryTableFactory()));
+        if (valid)
+        {
+            memoryTableFactory->merge(*(speculation.context->getMemoryTableFactory()));
+            executiveContext->setAddressCount(speculation.context->addressCount());
+            auto const& receipt = speculation.receipt;
+            block.appendTransactionReceipt(
+                TransactionReceipt(executiveContext->getState()->rootHash(),
+                    gasUsed + receipt.gasUsed(), receipt.log(), receipt.status(),
+                    receipt.outputBytes(), receipt.contractAddress()));
+        }
+        else
+        {
+            ++reexecuted;
+            EnvInfo envInfo(block.blockHeader(), m_pNumberHash, gasUsed);
+            envInfo.setPrecompiledEngine(executiveContext);
+            std::pair<ExecutionResult, TransactionReceipt> resultReceipt =
+                execute(envInfo, transactions[i], OnOpFunc(), executiveContext);
+            block.appendTransactionReceipt(resultReceipt.second);
+        }
+        commitTransaction(executiveContext);
+        speculation.context = nullptr;
+    }
+    BLOCKVERIFIER_LOG(DEBUG) << "[#executeParallel] [txNum/reexecuted]: " << transactions.size()
+                             << "/" << reexecuted;
+}
+
+void BlockVerifier::commitTransaction(ExecutiveContext::Ptr executiveContext)
+{
+    executiveContext->clearTransientPrecompiled();
+    if (m_intermediateRoot)
+    {
+        executiveContext->getState()->commit();
+    }
+    else
+    {
+        executiveContext->getState()->commitTransaction();
+    }
+}
+
+void BlockVerifier::speculate(
+    Block& block, BlockInfo const& parentBlockInfo, size_t index, Speculation& speculation)
+{
+    try
+    {
+        ExecutiveContext::Ptr context = std::make_shared<ExecutiveContext>();
+        m_executiveContextFactory->initExecutiveContext(
+            parentBlockInfo, parentBlockInfo.stateRoot, context);
+        context->setAddressCount(speculation.addressCount);
+
+        EnvInfo envInfo(block.blockHeader(), m_pNumberHash, 0);
+        envInfo.setPrecompiledEngine(context);
+        auto resultReceipt = execute(envInfo, block.transactions()[index], OnOpFunc(), context);
+        speculation.receipt = resultReceipt.second;
+        speculation.context = context;
+    }
+    catch (std::exception& e)
+    {
+        // executed again on the block context, which reports the error if any
+        BLOCKVERIFIER_LOG(TRACE) << "[#speculate] failed [index/errorMsg]: " << index << "/"
+                                 << boost::diagnostic_information(e);
+        speculation.context = nullptr;
+    }
+    catch (...)
+    {
+        speculation.context = nullptr;
+    }
+}
+
+void BlockVerifier::runParallel(
+    std::vector<size_t> const& indexes, std::function<void(size_t)> const& f)
+{
+    std::mutex lock;
+    std::condition_variable finished;
+    size_t pending = indexes.size();
+    for (auto index : indexes)
+    {
+        m_executePool->enqueue([&, index]() {
+            f(index);
+            std::lock_guard<std::mutex> l(lock);
+            --pending;
+            finished.notify_all();
+        });
+    }
+    std::unique_lock<std::mutex> l(lock);
+    finished.wait(l, [&]() { return pending == 0; });
+}
+
 std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::executeTransaction(
     const BlockHeader& blockHeader, dev::eth::Transaction const& _t)
 {
-    ExecutiveContext::Ptr executiveContext = std::make_shared<ExecutiveContext>();
     BlockInfo blockInfo{blockHeader.hash(), blockHeader.number(), blockHeader.stateRoot()};
+    // a context which throws is dropped instead of released
+    CallContext callContext = acquireCallContext(blockInfo);
+    ExecutiveContext::Ptr executiveContext = callContext.context;
+
+    EnvInfo envInfo(blockHeader, m_pNumberHash, 0);
+    envInfo.setPrecompiledEngine(executiveContext);
+    ExecutionResult res;
+    TransactionReceipt receipt;
+    {
+        Executive e(executiveContext->getState(), envInfo);
+        e.setResultRecipient(res);
+        e.initialize(_t);
+        if (!e.execute())
+            e.go();
+        e.finalize();
+
+        // the changes are dropped, computing the state root would be a waste
+        receipt = TransactionReceipt(h256(), e.gasUsed(), e.logs(), e.status(),
+            e.takeOutput().takeBytes(), e.newAddress());
+    }
+    releaseCallContext(blockInfo, callContext);
+    return make_pair(res, receipt);
+}
+
+BlockVerifier::CallContext BlockVerifier::acquireCallContext(BlockInfo const& blockInfo)
+{
+    {
+        Guard l(m_callContextsLock);
+        if (blockInfo.hash == m_callBlock.hash && !m_callContexts.empty())
+        {
+            CallContext callContext = m_callContexts.back();
+            m_callContexts.pop_back();
+            return callContext;
+        }
+        if (blockInfo.number >= m_callBlock.number && blockInfo.hash != m_callBlock.hash)
+        {
+            // the contexts of an older block are never used again
+            m_callContexts.clear();
+            m_callBlock = blockInfo;
+        }
+    }
+
+    CallContext callContext{std::make_shared<ExecutiveContext>(), -1};
     try
     {
         m_executiveContextFactory->initExecutiveContext(
-            blockInfo, blockHeader.stateRoot(), executiveContext);
+            blockInfo, blockInfo.stateRoot, callContext.context);
+        // the rows selected by a call may be changed in place, outside the change log
+        callContext.context->getMemoryTableFactory()->setSelectCopies(true);
+        callContext.addressCount = callContext.context->addressCount();
     }
     catch (exception& e)
     {
@@ -98,10 +344,31 @@ std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::executeTransaction
             << "[#executeTransaction] Error during execute initExecutiveContext [errorMsg]: "
             << boost::diagnostic_information(e);
     }
+    return callContext;
+}
 
-    EnvInfo envInfo(blockHeader, m_pNumberHash, 0);
-    envInfo.setPrecompiledEngine(executiveContext);
-    return execute(envInfo, _t, OnOpFunc(), executiveContext);
+void BlockVerifier::releaseCallContext(BlockInfo const& blockInfo, CallContext& callContext)
+{
+    if (callContext.addressCount < 0)
+    {
+        return;
+    }
+    auto executiveContext = callContext.context;
+    // the tables read by the call stay loaded in the memory table factory, the call only got
+    // copies of their rows, see acquireCallContext
+    executiveContext->getState()->rollback(0);
+    executiveContext->getMemoryTableFactory()->rollback(0);
+    // neither the code cache of the storage state nor a killed account of the mpt state is in
+    // the change log
+    executiveContext->getState()->clear();
+    executiveContext->clearTransientPrecompiled();
+    executiveContext->setAddressCount(callContext.addressCount);
+
+    Guard l(m_callContextsLock);
+    if (blockInfo.hash == m_callBlock.hash && m_callContexts.size() < c_maxCallContexts)
+    {
+        m_callContexts.push_back(callContext);
+    }
 }
 
 std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::execute(EnvInfo const& _envInfo,
@@ -25,6 +25,8 @@
 #include "ExecutiveContextFactory.h"
 #include "Precompiled.h"
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/easylog.h>
 #include <libdevcrypto/Common.h>
 #include <libethcore/Block.h>
@@ -34,6 +36,7 @@
 #include <libexecutive/ExecutionResult.h>
 #include <libmptstate/State.h>
 #include <boost/function.hpp>
+#include <functional>
 #include <memory>
 namespace dev
 {
@@ -64,6 +67,9 @@ public:
 
     ExecutiveContext::Ptr executeBlock(dev::eth::Block& block, BlockInfo const& parentBlockInfo);
 
+    /// execute a call on the state of blockHeader and drop its changes, the receipt has no state
+    /// root, calls on the same block reuse the contexts of the previous ones and can run on any
+    /// number of threads
     std::pair<dev::executive::ExecutionResult, dev::eth::TransactionReceipt> executeTransaction(
         const dev::eth::BlockHeader& blockHeader, dev::eth::Transaction const& _t);
 
@@ -83,9 +89,58 @@ public:
         m_pNumberHash = _pNumberHash;
     }
 
+    /// execute the transactions of a block speculatively on _threadNum threads
+    /// 0 disables parallel execution, only supported by the storage state
+    void setParallelThreads(size_t _threadNum);
+
+    /// commit the state after every transaction so that receipts carry the intermediate state
+    /// root, otherwise the state is committed once at the end of the block
+    /// all the nodes of a group must use the same setting
+    void setIntermediateRoot(bool _intermediateRoot) { m_intermediateRoot = _intermediateRoot; }
+
 private:
+    struct Speculation
+    {
+        /// nullptr if the speculative execution failed
+        ExecutiveContext::Ptr context;
+        /// precompiled address counter the execution started from
+        int addressCount;
+        /// receipt with the gas used by this transaction only
+        dev::eth::TransactionReceipt receipt;
+    };
+
+    void executeParallel(dev::eth::Block& block, BlockInfo const& parentBlockInfo,
+        ExecutiveContext::Ptr executiveContext);
+    void speculate(dev::eth::Block& block, BlockInfo const& parentBlockInfo, size_t index,
+        Speculation& speculation);
+    void runParallel(std::vector<size_t> const& indexes, std::function<void(size_t)> const& f);
+    void commitTransaction(ExecutiveContext::Ptr executiveContext);
+    /// read the accounts of the transactions before the execution, in one batch
+    void prefetch(dev::eth::Block const& block, ExecutiveContext::Ptr executiveContext);
+
+    struct CallContext
+    {
+        ExecutiveContext::Ptr context;
+        /// precompiled address counter after the system precompileds are registered, -1 if the
+        /// context failed to initialize and is not reused
+        int addressCount;
+    };
+
+    CallContext acquireCallContext(BlockInfo const& blockInfo);
+    /// drop the changes of the call and keep the context for the next call on the same block
+    void releaseCallContext(BlockInfo const& blockInfo, CallContext& callContext);
+
     ExecutiveContextFactory::Ptr m_executiveContextFactory;
     NumberHashCallBackFunction m_pNumberHash;
+    std::shared_ptr<dev::ThreadPool> m_executePool;
+    bool m_intermediateRoot = true;
+
+    /// idle contexts of the calls on m_callBlock, built on the latest block seen by a call
+    std::vector<CallContext> m_callContexts;
+    BlockInfo m_callBlock{dev::h256(), -1, dev::h256()};
+    Mutex m_callContextsLock;
+    /// more contexts than concurrent calls are never used, this only bounds the memory
+    static const size_t c_maxCallContexts = 64;
 };
 
 }  // namespace blockverifier
@@ -73,6 +73,26 @@ Address ExecutiveContext::registerPrecompiled(Precompiled::Ptr p)
     return address;
 }
 
+Address ExecutiveContext::registerTransientPrecompiled(Precompiled::Ptr p)
+{
+    Address address(++m_addressCount);
+
+    if (m_transientPrecompiled.empty())
+    {
+        m_transientBase = m_addressCount;
+    }
+    m_transientPrecompiled.resize(m_addressCount - m_transientBase + 1);
+    m_transientPrecompiled.back() = p;
+
+    return address;
+}
+
+void ExecutiveContext::clearTransientPrecompiled()
+{
+    // keeps the capacity for the next transaction
+    m_transientPrecompiled.clear();
+}
+
 
 bool ExecutiveContext::isPrecompiled(Address address) const
 {
@@ -93,6 +113,18 @@ Precompiled::Ptr ExecutiveContext::getPrecompiled(Address address) const
     LOG(TRACE) << "PrecompiledEngine getPrecompiled:" << m_blockInfo.hash << " " << address;
 
     LOG(TRACE) << "address size:" << m_address2Precompiled.size();
+    if (!m_transientPrecompiled.empty())
+    {
+        u160 number = address;
+        if (number >= m_transientBase && number < m_transientBase + m_transientPrecompiled.size())
+        {
+            auto& p = m_transientPrecompiled[size_t(number - m_transientBase)];
+            if (p)
+            {
+                return p;
+            }
+        }
+    }
     auto itPrecompiled = m_address2Precompiled.find(address);
 
     if (itPrecompiled != m_address2Precompiled.end())
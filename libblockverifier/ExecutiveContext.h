@@ -59,8 +59,20 @@ public:
 
     virtual Address registerPrecompiled(Precompiled::Ptr p);
 
+    /// register a precompiled which is only valid in the current transaction, like the
+    /// Entries, Entry and Condition objects returned by the table precompileds
+    virtual Address registerTransientPrecompiled(Precompiled::Ptr p);
+
+    /// free the transient precompileds at the end of a transaction, the addresses are not
+    /// reused
+    void clearTransientPrecompiled();
+
     virtual bool isPrecompiled(Address address) const;
 
+    /// the address of the last registered precompiled
+    int addressCount() const { return m_addressCount; }
+    void setAddressCount(int _addressCount) { m_addressCount = _addressCount; }
+
     Precompiled::Ptr getPrecompiled(Address address) const;
 
     void setAddress2Precompiled(Address address, Precompiled::Ptr precompiled)
@@ -102,6 +114,10 @@ public:
 
 private:
     std::unordered_map<Address, Precompiled::Ptr> m_address2Precompiled;
+    /// transient precompileds of the current transaction indexed by address - m_transientBase,
+    /// the slots of the addresses registered by registerPrecompiled() are empty
+    std::vector<Precompiled::Ptr> m_transientPrecompiled;
+    int m_transientBase = 0;
     int m_addressCount = 0x10000;
     BlockInfo m_blockInfo;
     std::shared_ptr<dev::executive::StateFace> m_stateFace;
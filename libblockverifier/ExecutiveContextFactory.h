@@ -57,10 +57,14 @@ public:
     virtual void setStateFactory(
         std::shared_ptr<dev::executive::StateFactoryInterface> stateFactoryInterface);
 
+    /// see MemoryTable::setExactConditions, fixed when the chain is created
+    void setExactConditions(bool _exactConditions) { m_exactConditions = _exactConditions; }
+
 private:
     dev::storage::Storage::Ptr m_stateStorage;
     std::shared_ptr<dev::executive::StateFactoryInterface> m_stateFactoryInterface;
     std::unordered_map<Address, dev::eth::PrecompiledContract> m_precompiledContract;
+    bool m_exactConditions = false;
 
     void setTxGasLimitToContext(ExecutiveContext::Ptr context);
 };
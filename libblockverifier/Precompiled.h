@@ -36,6 +36,16 @@ class Table;
 namespace blockverifier
 {
 class ExecutiveContext;
+
+/// selector of a method, precompileds created per call compute theirs once on static
+/// initialization with this instead of in every constructor
+inline uint32_t getFuncSelector(std::string const& _functionName)
+{
+    uint32_t func = *(uint32_t*)(sha3(_functionName).ref().cropped(0, 4).data());
+    return ((func & 0x000000FF) << 24) | ((func & 0x0000FF00) << 8) |
+           ((func & 0x00FF0000) >> 8) | ((func & 0xFF000000) >> 24);
+}
+
 class Precompiled : public std::enable_shared_from_this<Precompiled>
 {
 public:
@@ -59,9 +69,7 @@ public:
 
     virtual uint32_t getFuncSelector(std::string const& _functionName)
     {
-        uint32_t func = *(uint32_t*)(sha3(_functionName).ref().cropped(0, 4).data());
-        return ((func & 0x000000FF) << 24) | ((func & 0x0000FF00) << 8) |
-               ((func & 0x00FF0000) >> 8) | ((func & 0xFF000000) >> 24);
+        return dev::blockverifier::getFuncSelector(_functionName);
     }
     virtual bytesConstRef getParamData(bytesConstRef param) { return param.cropped(4); }
 
@@ -56,8 +56,8 @@ enum NodeAccountType
 struct Sealing
 {
     dev::eth::Block block;
-    /// hash set for filter fetched transactions
-    h256Hash m_transactionSet;
+    /// txpool cursor of the last fetched transaction
+    uint64_t m_txsCursor = 0;
     dev::blockverifier::ExecutiveContext::Ptr p_execContext;
 };
 
@@ -140,10 +140,10 @@ void Sealer::doWork(bool wait)
  */
 void Sealer::loadTransactions(uint64_t const& transToFetch)
 {
-    /// fetch transactions and update m_transactionSet
+    /// fetch transactions and move m_txsCursor past them
     SEAL_LOG(DEBUG) << "[#loadTransactions] [transToFetch]: " << transToFetch;
     m_sealing.block.appendTransactions(
-        m_txPool->topTransactions(transToFetch, m_sealing.m_transactionSet, true));
+        m_txPool->topTransactions(transToFetch, m_sealing.m_txsCursor));
 }
 
 /// check whether the blocksync module is syncing
@@ -156,7 +156,7 @@ bool Sealer::isBlockSyncing()
 void Sealer::resetSealingBlock(Sealing& sealing)
 {
     resetBlock(sealing.block);
-    sealing.m_transactionSet.clear();
+    sealing.m_txsCursor = 0;
     sealing.p_execContext = nullptr;
 }
 
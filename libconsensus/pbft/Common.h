@@ -48,6 +48,11 @@ enum PBFTPacketType : byte
     SignReqPacket = 0x01,
     CommitReqPacket = 0x02,
     ViewChangeReqPacket = 0x03,
+    /// prepare request carrying the block header and the transaction hashes
+    CompactPrepareReqPacket = 0x04,
+    /// request for the transactions of a compact prepare missed in the txpool
+    MissedTxsReqPacket = 0x05,
+    MissedTxsRespPacket = 0x06,
     PBFTPacketCount
 };
 
@@ -442,5 +447,54 @@ struct ViewChangeReq : public PBFTMsg
         sig2 = signHash(fieldsWithoutBlock(), keyPair);
     }
 };
+
+/// request for the transactions of a compact prepare that are missed in the txpool
+struct MissedTxsReq
+{
+    /// block hash of the compact prepare
+    h256 block_hash;
+    /// indexes of the missed transactions in the block, empty to request the full prepare
+    std::vector<uint32_t> indexes;
+
+    void encode(bytes& encodedBytes) const
+    {
+        RLPStream s(2);
+        s << block_hash << indexes;
+        s.swapOut(encodedBytes);
+    }
+    /// @Exception Case: if decode failed, throw exception directly
+    void decode(bytesConstRef data)
+    {
+        RLP rlp(data);
+        block_hash = rlp[0].toHash<h256>(RLP::VeryStrict);
+        indexes = rlp[1].toVector<uint32_t>();
+    }
+};
+
+/// the encoded transactions answering a MissedTxsReq, in the order of the requested indexes
+struct MissedTxsResp
+{
+    h256 block_hash;
+    std::vector<bytes> txs;
+
+    void encode(bytes& encodedBytes) const
+    {
+        RLPStream s(2);
+        s << block_hash;
+        s.appendList(txs.size());
+        for (auto const& tx : txs)
+            s.appendRaw(tx);
+        s.swapOut(encodedBytes);
+    }
+    /// @Exception Case: if decode failed, throw exception directly
+    void decode(bytesConstRef data)
+    {
+        RLP rlp(data);
+        block_hash = rlp[0].toHash<h256>(RLP::VeryStrict);
+        txs.clear();
+        for (auto const& tx : rlp[1])
+            txs.push_back(tx.data().toBytes());
+    }
+};
 }  // namespace consensus
 }  // namespace dev
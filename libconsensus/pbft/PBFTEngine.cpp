@@ -47,6 +47,13 @@ void PBFTEngine::start()
     PBFTENGINE_LOG(INFO) << "[#Start PBFTEngine...]";
 }
 
+void PBFTEngine::setVerifyThreads(size_t _threadNum)
+{
+    _threadNum = std::max(_threadNum, size_t(1));
+    m_verifyPool = std::make_shared<dev::ThreadPool>("PBFTVerify", _threadNum);
+    m_sealVerifyPool = std::make_shared<dev::ThreadPool>("PBFTSealVerify", _threadNum);
+}
+
 void PBFTEngine::initPBFTEnv(unsigned view_timeout)
 {
     Guard l(m_mutex);
@@ -219,9 +226,19 @@ bool PBFTEngine::generatePrepare(Block const& block)
     Guard l(m_mutex);
     PrepareReq prepare_req(block, m_keyPair, m_view, m_idx);
     bytes prepare_data;
-    prepare_req.encode(prepare_data);
+    unsigned packetType = PrepareReqPacket;
+    if (m_compactPrepare && block.getTransactionSize() > 0)
+    {
+        /// the signatures don't cover the block data, the compact prepare is signed the same way
+        PrepareReq compact_req(prepare_req);
+        compact_req.block = encodeCompactBlock(block);
+        compact_req.encode(prepare_data);
+        packetType = CompactPrepareReqPacket;
+    }
+    else
+        prepare_req.encode(prepare_data);
     /// broadcast the generated preparePacket
-    bool succ = broadcastMsg(PrepareReqPacket, prepare_req.uniqueKey(), ref(prepare_data));
+    bool succ = broadcastMsg(packetType, prepare_req.uniqueKey(), ref(prepare_data));
     if (succ)
     {
         if (block.getTransactionSize() == 0 && m_omitEmptyBlock)
@@ -241,6 +258,20 @@ bool PBFTEngine::generatePrepare(Block const& block)
     return succ;
 }
 
+bytes PBFTEngine::encodeCompactBlock(Block const& block)
+{
+    bytes header_data;
+    block.blockHeader().encode(header_data);
+    h256s tx_hashes;
+    tx_hashes.reserve(block.getTransactionSize());
+    for (auto const& tx : block.transactions())
+        tx_hashes.push_back(tx.sha3());
+    RLPStream compact(2);
+    compact.appendRaw(header_data);
+    compact << tx_hashes;
+    return compact.out();
+}
+
 /**
  * @brief : 1. generate and broadcast signReq according to given prepareReq,
  *          2. add the generated signReq into the cache
@@ -274,6 +305,11 @@ bool PBFTEngine::checkSign(PBFTMsg const& req) const
     h512 node_id;
     if (getNodeIDByIndex(node_id, req.idx))
     {
+        {
+            ReadGuard l(x_verifiedSigns);
+            if (m_verifiedSigns.count(signKey(node_id, req)))
+                return true;
+        }
         Public pub_id = jsToPublic(toJS(node_id.hex()));
         return dev::verify(pub_id, req.sig, req.block_hash) &&
                dev::verify(pub_id, req.sig2, req.fieldsWithoutBlock());
@@ -281,6 +317,47 @@ bool PBFTEngine::checkSign(PBFTMsg const& req) const
     return false;
 }
 
+void PBFTEngine::preVerifySign(PBFTMsgPacket const& _packet)
+{
+    try
+    {
+        /// every request starts with the fields of PBFTMsg
+        PBFTMsg req;
+        req.decode(ref(_packet.data));
+        h512 node_id;
+        {
+            ReadGuard l(m_minerListMutex);
+            node_id = getMinerByIndex(req.idx);
+        }
+        if (node_id == h512())
+            return;
+        if (dev::verify(node_id, req.sig, req.block_hash) &&
+            dev::verify(node_id, req.sig2, req.fieldsWithoutBlock()))
+            addVerifiedSign(signKey(node_id, req));
+    }
+    catch (std::exception const& e)
+    {
+        /// the workLoop rejects the malformed message
+        PBFTENGINE_LOG(TRACE) << "[#preVerifySign] decode failed: [EINFO]:  " << e.what();
+    }
+}
+
+void PBFTEngine::addVerifiedSign(h256 const& _key)
+{
+    WriteGuard l(x_verifiedSigns);
+    if (m_verifiedSigns.size() >= c_maxVerifiedSigns)
+        m_verifiedSigns.clear();
+    m_verifiedSigns.insert(_key);
+}
+
+h256 PBFTEngine::signKey(h512 const& _nodeId, PBFTMsg const& _req)
+{
+    RLPStream s(5);
+    s << _nodeId << _req.block_hash << _req.fieldsWithoutBlock() << _req.sig.asBytes()
+      << _req.sig2.asBytes();
+    return sha3(s.out());
+}
+
 /**
  * @brief: 1. generate commitReq according to prepare req
  *         2. broadcast the commitReq
@@ -371,6 +448,17 @@ bool PBFTEngine::sendMsg(dev::network::NodeID const& nodeId, unsigned const& pac
     return false;
 }
 
+bool PBFTEngine::sendToNode(h512 const& nodeId, unsigned const& packetType, bytesConstRef data)
+{
+    if (nodeId == h512() || !m_service->isConnected(nodeId))
+        return false;
+    m_service->asyncSendMessageByNodeID(nodeId, transDataToMessage(data, packetType, 1), nullptr);
+    PBFTENGINE_LOG(DEBUG) << "[#sendToNode] [myIdx/myNode/dstNodeId/packetType/size]: "
+                          << nodeIdx() << "/" << m_keyPair.pub().abridged() << "/"
+                          << nodeId.abridged() << "/" << packetType << "/" << data.size();
+    return true;
+}
+
 /**
  * @brief: broadcast specified message to all-peers with cache-filter and specified filter
  *         broadcast solutions:
@@ -515,23 +603,10 @@ bool PBFTEngine::checkBlock(Block const& block)
         return false;
     }
     /// check sign
-    for (auto sign : sig_list)
+    if (!checkSigList(block))
     {
-        if (sign.first >= m_minerList.size())
-        {
-            LOG(ERROR) << "[#checkBlock] invalid idx [idx/minerSize]: " << sign.first << "/"
-                       << m_minerList.size();
-            return false;
-        }
-        if (!dev::verify(m_minerList[sign.first.convert_to<size_t>()], sign.second,
-                block.blockHeader().hash()))
-        {
-            LOG(ERROR) << "[#checkBlock] invalid sign [idx/pub/hash]: " << sign.first << "/"
-                       << m_minerList[sign.first.convert_to<size_t>()].abridged() << "/"
-                       << block.blockHeader().hash().abridged();
-            return false;
-        }
-    }  /// end of check sign
+        return false;
+    }
 
     /// Check whether the number of transactions in block exceeds the limit
     std::string ret =
@@ -544,6 +619,45 @@ bool PBFTEngine::checkBlock(Block const& block)
     return true;
 }
 
+bool PBFTEngine::checkSigList(Block const& block)
+{
+    auto sig_list = block.sigList();
+    for (auto const& sign : sig_list)
+    {
+        if (sign.first >= m_minerList.size())
+        {
+            LOG(ERROR) << "[#checkBlock] invalid idx [idx/minerSize]: " << sign.first << "/"
+                       << m_minerList.size();
+            return false;
+        }
+    }
+    /// verify the signatures in parallel
+    h256 block_hash = block.blockHeader().hash();
+    std::atomic<bool> valid = {true};
+    std::mutex lock;
+    std::condition_variable finished;
+    size_t pending = sig_list.size();
+    for (size_t i = 0; i < sig_list.size(); ++i)
+    {
+        m_sealVerifyPool->enqueue([&, i]() {
+            auto const& sign = sig_list[i];
+            auto const& pub = m_minerList[sign.first.convert_to<size_t>()];
+            if (!dev::verify(pub, sign.second, block_hash))
+            {
+                LOG(ERROR) << "[#checkBlock] invalid sign [idx/pub/hash]: " << sign.first << "/"
+                           << pub.abridged() << "/" << block_hash.abridged();
+                valid = false;
+            }
+            std::lock_guard<std::mutex> l(lock);
+            --pending;
+            finished.notify_all();
+        });
+    }
+    std::unique_lock<std::mutex> l(lock);
+    finished.wait(l, [&]() { return pending == 0; });
+    return valid;
+}
+
 void PBFTEngine::execBlock(Sealing& sealing, PrepareReq const& req, std::ostringstream& oss)
 {
     auto start_exec_time = utcTime();
@@ -595,8 +709,11 @@ void PBFTEngine::onRecvPBFTMessage(
     bool valid = decodeToRequests(pbft_msg, message, session);
     if (!valid)
         return;
-    if (pbft_msg.packet_id <= ViewChangeReqPacket)
+    if (pbft_msg.packet_id < PBFTPacketCount)
     {
+        /// the signatures are verified in parallel while the message waits in m_msgQueue
+        if (pbft_msg.packet_id <= CompactPrepareReqPacket)
+            m_verifyPool->enqueue([this, pbft_msg]() { preVerifySign(pbft_msg); });
         m_msgQueue.push(pbft_msg);
     }
     else
@@ -615,6 +732,206 @@ void PBFTEngine::handlePrepareMsg(PrepareReq& prepare_req, PBFTMsgPacket const&
     handlePrepareMsg(prepare_req, pbftMsg.endpoint);
 }
 
+/**
+ * @brief: handle the compact prepare request:
+ *       1. check the prepare like a full one: leader, view, height and signature, the prepare
+ *          of a future block is kept until handleFutureBlock reaches it
+ *       2. rebuild the block from the header and the transactions in the txpool
+ *       3. if all the transactions are found, handle the prepare with the rebuilt block
+ *       4. else request the missed transactions from the leader(or the forwarder of the
+ *          prepare), and request the full prepare if most of the transactions are missed
+ */
+void PBFTEngine::handleCompactPrepareMsg(PrepareReq& prepareReq, PBFTMsgPacket const& pbftMsg)
+{
+    bool valid = decodeToRequests(prepareReq, ref(pbftMsg.data));
+    if (!valid)
+        return;
+    handleCompactPrepare(prepareReq, pbftMsg.endpoint, pbftMsg.node_id);
+}
+
+void PBFTEngine::handleCompactPrepare(
+    PrepareReq& prepareReq, std::string const& endpoint, h512 const& nodeId)
+{
+    if (m_partialPrepare && m_partialPrepare->req.block_hash == prepareReq.block_hash)
+        return;
+    std::ostringstream oss;
+    oss << "[#handleCompactPrepareMsg] [myIdx/myNode/idx/view/number/consNum/fromIp/hash]:  "
+        << nodeIdx() << "/" << m_keyPair.pub().abridged() << "/" << prepareReq.idx << "/"
+        << prepareReq.view << "/" << prepareReq.height << "/" << m_consensusBlockNumber << "/"
+        << endpoint << "/" << prepareReq.block_hash.abridged();
+    /// the leader seals the next block while this node is still committing the current one,
+    /// the block is rebuilt from the txpool once handleFutureBlock reaches it
+    if (isFutureBlock(prepareReq))
+    {
+        PBFTENGINE_LOG(INFO) << "[#handleCompactPrepareMsg] Future prepare: [INFO]:  " << oss.str();
+        if (!m_futureCompactPrepare ||
+            m_futureCompactPrepare->req.block_hash != prepareReq.block_hash)
+        {
+            m_futureCompactPrepare = std::make_shared<PartialPrepare>();
+            m_futureCompactPrepare->req = prepareReq;
+            m_futureCompactPrepare->endpoint = endpoint;
+            m_futureCompactPrepare->nodeId = nodeId;
+        }
+        return;
+    }
+    if (!isValidPrepare(prepareReq, oss))
+        return;
+    auto partial = std::make_shared<PartialPrepare>();
+    try
+    {
+        RLP compact(prepareReq.block);
+        partial->header = BlockHeader(compact[0].data(), HeaderData);
+        partial->txs = m_txPool->getTransactions(compact[1].toVector<h256>(), partial->missed);
+    }
+    catch (std::exception const& e)
+    {
+        PBFTENGINE_LOG(WARNING) << "[#handleCompactPrepareMsg] Invalid compact prepare: [EINFO]:  "
+                                << boost::diagnostic_information(e);
+        return;
+    }
+    if (partial->missed.empty())
+    {
+        completeCompactPrepare(prepareReq, partial->header, partial->txs, endpoint);
+        return;
+    }
+    partial->req = prepareReq;
+    partial->endpoint = endpoint;
+    partial->nodeId = nodeId;
+    if (!requestMissedTxs(*partial))
+        return;
+    m_partialPrepare = partial;
+}
+
+/// the full prepare is requested if most of the transactions are missed
+bool PBFTEngine::requestMissedTxs(PartialPrepare& partial)
+{
+    MissedTxsReq req;
+    req.block_hash = partial.req.block_hash;
+    if (partial.missed.size() * 2 <= partial.txs.size())
+        req.indexes.assign(partial.missed.begin(), partial.missed.end());
+    bytes req_data;
+    req.encode(req_data);
+    partial.requestTime = utcTime();
+    if (!sendToNode(getMinerByIndex(partial.req.idx), MissedTxsReqPacket, ref(req_data)) &&
+        !sendToNode(partial.nodeId, MissedTxsReqPacket, ref(req_data)))
+    {
+        PBFTENGINE_LOG(WARNING) << "[#requestMissedTxs] Request missed txs failed: "
+                                   "[idx/hash/fromIp]:  "
+                                << partial.req.idx << "/" << partial.req.block_hash.abridged()
+                                << "/" << partial.endpoint;
+        return false;
+    }
+    PBFTENGINE_LOG(DEBUG) << "[#requestMissedTxs] Request missed txs: "
+                             "[myIdx/number/hash/missed/txs/full]:  "
+                          << nodeIdx() << "/" << partial.req.height << "/"
+                          << partial.req.block_hash.abridged() << "/" << partial.missed.size()
+                          << "/" << partial.txs.size() << "/" << req.indexes.empty();
+    return true;
+}
+
+void PBFTEngine::completeCompactPrepare(PrepareReq& prepareReq, BlockHeader const& header,
+    Transactions const& txs, std::string const& endpoint)
+{
+    Block block;
+    block.setBlockHeader(header);
+    block.setTransactions(txs);
+    block.calTransactionRoot();
+    /// the transactions must be the ones sealed by the leader
+    if (header.hash() != prepareReq.block_hash ||
+        block.blockHeader().transactionsRoot() != header.transactionsRoot())
+    {
+        PBFTENGINE_LOG(WARNING) << "[#completeCompactPrepare] Rebuilt block mismatch: "
+                                   "[idx/hash/headerHash/fromIp]:  "
+                                << prepareReq.idx << "/" << prepareReq.block_hash.abridged() << "/"
+                                << header.hash().abridged() << "/" << endpoint;
+        return;
+    }
+    block.encode(prepareReq.block);
+    handlePrepareMsg(prepareReq, endpoint);
+}
+
+void PBFTEngine::handleMissedTxsReq(PBFTMsgPacket const& pbftMsg)
+{
+    MissedTxsReq req;
+    try
+    {
+        req.decode(ref(pbftMsg.data));
+    }
+    catch (std::exception const& e)
+    {
+        PBFTENGINE_LOG(WARNING) << "[#handleMissedTxsReq] Invalid request: [EINFO]:  "
+                                << boost::diagnostic_information(e);
+        return;
+    }
+    /// the prepare being handled, or the committed one
+    PrepareReq const* prepare = &m_reqCache->rawPrepareCache();
+    if (prepare->block_hash != req.block_hash)
+        prepare = &m_reqCache->committedPrepareCache();
+    if (prepare->block_hash != req.block_hash || prepare->block.empty())
+    {
+        PBFTENGINE_LOG(DEBUG) << "[#handleMissedTxsReq] Prepare not found: [hash/fromIp]:  "
+                              << req.block_hash.abridged() << "/" << pbftMsg.endpoint;
+        return;
+    }
+    bytes resp_data;
+    unsigned packetType = MissedTxsRespPacket;
+    if (req.indexes.empty())
+    {
+        prepare->encode(resp_data);
+        packetType = PrepareReqPacket;
+    }
+    else
+    {
+        MissedTxsResp resp;
+        resp.block_hash = req.block_hash;
+        RLP txs = BlockHeader::extractBlock(ref(prepare->block))[1];
+        for (auto index : req.indexes)
+        {
+            if (index >= txs.itemCount())
+            {
+                PBFTENGINE_LOG(WARNING) << "[#handleMissedTxsReq] Invalid index: [index/txs]:  "
+                                        << index << "/" << txs.itemCount();
+                return;
+            }
+            resp.txs.push_back(txs[index].data().toBytes());
+        }
+        resp.encode(resp_data);
+    }
+    sendToNode(pbftMsg.node_id, packetType, ref(resp_data));
+}
+
+void PBFTEngine::handleMissedTxsResp(PBFTMsgPacket const& pbftMsg)
+{
+    auto partial = m_partialPrepare;
+    if (!partial)
+        return;
+    try
+    {
+        MissedTxsResp resp;
+        resp.decode(ref(pbftMsg.data));
+        if (resp.block_hash != partial->req.block_hash)
+            return;
+        if (resp.txs.size() != partial->missed.size())
+        {
+            PBFTENGINE_LOG(WARNING) << "[#handleMissedTxsResp] Wrong tx count: [hash/txs/missed]:  "
+                                    << resp.block_hash.abridged() << "/" << resp.txs.size() << "/"
+                                    << partial->missed.size();
+            return;
+        }
+        for (size_t i = 0; i < resp.txs.size(); i++)
+            partial->txs[partial->missed[i]] =
+                Transaction(ref(resp.txs[i]), CheckTransaction::Everything);
+    }
+    catch (std::exception const& e)
+    {
+        PBFTENGINE_LOG(WARNING) << "[#handleMissedTxsResp] Invalid response: [EINFO]:  "
+                                << boost::diagnostic_information(e);
+        return;
+    }
+    m_partialPrepare.reset();
+    completeCompactPrepare(partial->req, partial->header, partial->txs, partial->endpoint);
+}
+
 /**
  * @brief: handle the prepare request:
  *       1. check whether the prepareReq is valid or not
@@ -635,6 +952,9 @@ void PBFTEngine::handlePrepareMsg(PrepareReq const& prepareReq, std::string cons
         << nodeIdx() << "/" << m_keyPair.pub().abridged() << "/" << prepareReq.idx << "/"
         << prepareReq.view << "/" << prepareReq.height << "/" << m_highestBlock.number() << "/"
         << m_consensusBlockNumber << "/" << endpoint << "/" << prepareReq.block_hash.abridged();
+    /// the full prepare answers the compact one
+    if (m_partialPrepare && m_partialPrepare->req.block_hash == prepareReq.block_hash)
+        m_partialPrepare.reset();
     /// check the prepare request is valid or not
     if (!isValidPrepare(prepareReq, oss))
         return;
@@ -820,6 +1140,7 @@ void PBFTEngine::reportBlock(Block const& block)
         resetConfig();
         m_reqCache->clearAllExceptCommitCache();
         m_reqCache->delCache(m_highestBlock.hash());
+        m_partialPrepare.reset();
         PBFTENGINE_LOG(INFO) << "^^^^^^^^^^^^^^^^^^^^^^^^^^^^^Report: number= "
                              << m_highestBlock.number() << ", idx= " << m_highestBlock.sealer()
                              << " , hash= " << m_highestBlock.hash().abridged()
@@ -1045,6 +1366,7 @@ void PBFTEngine::checkAndChangeView()
         m_timeManager.m_lastConsensusTime = utcTime();
         m_view = m_toView;
         m_reqCache->triggerViewChange(m_view);
+        m_partialPrepare.reset();
         m_blockSync->noteSealingBlockNumber(m_blockChain->number());
     }
 }
@@ -1072,6 +1394,10 @@ void PBFTEngine::checkTimeout()
     bool flag = false;
     {
         Guard l(m_mutex);
+        /// the request for the missed transactions or its response may have been lost
+        if (m_partialPrepare &&
+            utcTime() - m_partialPrepare->requestTime >= c_missedTxsRetryInterval)
+            requestMissedTxs(*m_partialPrepare);
         if (m_timeManager.isTimeout())
         {
             Timer t;
@@ -1109,6 +1435,21 @@ void PBFTEngine::handleMsg(PBFTMsgPacket const& pbftMsg)
         pbft_msg = prepare_req;
         break;
     }
+    case CompactPrepareReqPacket:
+    {
+        PrepareReq prepare_req;
+        handleCompactPrepareMsg(prepare_req, pbftMsg);
+        key = prepare_req.uniqueKey();
+        pbft_msg = prepare_req;
+        break;
+    }
+    /// the requested messages are not forwarded
+    case MissedTxsReqPacket:
+        handleMissedTxsReq(pbftMsg);
+        return;
+    case MissedTxsRespPacket:
+        handleMissedTxsResp(pbftMsg);
+        return;
     case SignReqPacket:
     {
         SignReq req;
@@ -1207,6 +1548,18 @@ void PBFTEngine::handleFutureBlock()
         handlePrepareMsg(future_req);
         m_reqCache->resetFuturePrepare();
     }
+    auto future_compact = m_futureCompactPrepare;
+    if (!future_compact || isFutureBlock(future_compact->req))
+        return;
+    m_futureCompactPrepare.reset();
+    if (future_compact->req.height == m_consensusBlockNumber && future_compact->req.view == m_view)
+    {
+        PBFTENGINE_LOG(INFO) << "[#handleFutureBlock] Compact prepare: [myIdx/number/view/hash]:  "
+                             << nodeIdx() << "/" << future_compact->req.height << "/"
+                             << m_view << "/" << future_compact->req.block_hash.abridged();
+        handleCompactPrepare(
+            future_compact->req, future_compact->endpoint, future_compact->nodeId);
+    }
 }
 
 /// get the status of PBFT consensus
@@ -29,8 +29,10 @@
 #include <libconsensus/ConsensusEngineBase.h>
 #include <libdevcore/FileSystem.h>
 #include <libdevcore/LevelDB.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/concurrent_queue.h>
 #include <sstream>
+#include <thread>
 
 #include <libp2p/P2PMessage.h>
 #include <libp2p/P2PSession.h>
@@ -47,6 +49,20 @@ enum CheckResult
     FUTURE = 2
 };
 using PBFTMsgQueue = dev::concurrent_queue<PBFTMsgPacket>;
+/// a compact prepare waiting for the transactions missed in the txpool
+struct PartialPrepare
+{
+    PrepareReq req;
+    dev::eth::BlockHeader header;
+    /// empty transactions at the missed indexes
+    dev::eth::Transactions txs;
+    std::vector<size_t> missed;
+    std::string endpoint;
+    /// the node which sent the prepare, asked when the leader can't be reached
+    h512 nodeId;
+    /// when the missed transactions were last requested
+    uint64_t requestTime = 0;
+};
 class PBFTEngine : public ConsensusEngineBase
 {
 public:
@@ -68,6 +84,7 @@ public:
             m_protocolId, boost::bind(&PBFTEngine::onRecvPBFTMessage, this, _1, _2, _3));
         m_broadCastCache = std::make_shared<PBFTBroadcastCache>();
         m_reqCache = std::make_shared<PBFTReqCache>(m_protocolId);
+        setVerifyThreads(std::thread::hardware_concurrency());
 
         /// register checkMinerList to blockSync for check MinerList
         m_blockSync->registerConsensusVerifyHandler(boost::bind(&PBFTEngine::checkBlock, this, _1));
@@ -113,6 +130,13 @@ public:
 
     void setMaxTTL(uint8_t const& ttl) { maxTTL = ttl; }
 
+    /// broadcast the header and the transaction hashes of the sealed blocks, the other miners
+    /// rebuild the blocks from their txpool and fetch the missed transactions from the leader
+    void setCompactPrepare(bool _compactPrepare) { m_compactPrepare = _compactPrepare; }
+
+    /// the threads of each signature verify pool, at least one, called before start()
+    void setVerifyThreads(size_t _threadNum);
+
 protected:
     void workLoop() override;
     void handleFutureBlock();
@@ -134,6 +158,8 @@ protected:
     void sendViewChangeMsg(dev::network::NodeID const& nodeId);
     bool sendMsg(dev::network::NodeID const& nodeId, unsigned const& packetType,
         std::string const& key, bytesConstRef data, unsigned const& ttl = 1);
+    /// send to the connected node without the broadcast filter, for the requested messages
+    bool sendToNode(h512 const& nodeId, unsigned const& packetType, bytesConstRef data);
     /// 1. generate and broadcast signReq according to given prepareReq
     /// 2. add the generated signReq into the cache
     bool broadcastSignReq(PrepareReq const& req);
@@ -149,6 +175,20 @@ protected:
     void handlePrepareMsg(PrepareReq const& prepare_req, std::string const& endpoint = "self");
     /// handler prepare messages
     void handlePrepareMsg(PrepareReq& prepareReq, PBFTMsgPacket const& pbftMsg);
+    /// rebuild the block of the compact prepare from the txpool, request the missed transactions
+    void handleCompactPrepareMsg(PrepareReq& prepareReq, PBFTMsgPacket const& pbftMsg);
+    void handleCompactPrepare(
+        PrepareReq& prepareReq, std::string const& endpoint, h512 const& nodeId);
+    /// request the missed transactions from the leader, or from the node sent the prepare
+    bool requestMissedTxs(PartialPrepare& partial);
+    /// check the rebuilt block against the prepare, then handle the prepare with the full block
+    void completeCompactPrepare(PrepareReq& prepareReq, dev::eth::BlockHeader const& header,
+        dev::eth::Transactions const& txs, std::string const& endpoint);
+    /// answer the missed transactions of the prepare, or the full prepare
+    void handleMissedTxsReq(PBFTMsgPacket const& pbftMsg);
+    void handleMissedTxsResp(PBFTMsgPacket const& pbftMsg);
+    /// the block header and the transaction hashes of the block
+    static bytes encodeCompactBlock(dev::eth::Block const& block);
     /// 1. decode the network-received PBFTMsgPacket to signReq
     /// 2. check the validation of the signReq
     /// add the signReq to the cache and
@@ -174,6 +214,15 @@ protected:
     inline std::string getBackupMsgPath() { return m_baseDir + "/" + c_backupMsgDirName; }
 
     bool checkSign(PBFTMsg const& req) const;
+    /// verify the signatures of a received message on the verify workers, so that checkSign
+    /// finds them verified when the workLoop handles the message
+    void preVerifySign(PBFTMsgPacket const& _packet);
+    /// record a verified signature, the records are dropped once c_maxVerifiedSigns is reached
+    void addVerifiedSign(h256 const& _key);
+    /// key of a verified signature, binds the signer and the signed fields
+    static h256 signKey(h512 const& _nodeId, PBFTMsg const& _req);
+    /// verify the sig_list of the block on the seal verify workers, caller holds m_minerListMutex
+    bool checkSigList(dev::eth::Block const& block);
     inline bool broadcastFilter(
         h512 const& nodeId, unsigned const& packetType, std::string const& key)
     {
@@ -454,6 +503,8 @@ protected:
     static const std::string c_backupKeyCommitted;
     static const std::string c_backupMsgDirName;
     static const unsigned c_PopWaitSeconds = 5;
+    /// milliseconds to wait for the missed transactions before requesting them again
+    static const unsigned c_missedTxsRetryInterval = 1000;
 
     std::shared_ptr<PBFTBroadcastCache> m_broadCastCache;
     std::shared_ptr<PBFTReqCache> m_reqCache;
@@ -471,6 +522,19 @@ protected:
     bool m_emptyBlockViewChange = false;
 
     uint8_t maxTTL = MAXTTL;
+
+    /// signatures verified ahead of the workLoop
+    mutable SharedMutex x_verifiedSigns;
+    h256Hash m_verifiedSigns;
+    static const size_t c_maxVerifiedSigns = 10000;
+    std::shared_ptr<dev::ThreadPool> m_verifyPool;
+    /// the block seals are checked on their own workers, never behind the message signatures
+    std::shared_ptr<dev::ThreadPool> m_sealVerifyPool;
+
+    bool m_compactPrepare = false;
+    std::shared_ptr<PartialPrepare> m_partialPrepare;
+    /// the compact prepare of the next block, rebuilt by handleFutureBlock
+    std::shared_ptr<PartialPrepare> m_futureCompactPrepare;
 };
 }  // namespace consensus
 }  // namespace dev
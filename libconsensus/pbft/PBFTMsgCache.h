@@ -50,7 +50,9 @@ public:
     {
         switch (type)
         {
+        /// a node knowing the prepare needs neither of its forms
         case PrepareReqPacket:
+        case CompactPrepareReqPacket:
             insertMessage(x_knownPrepare, m_knownPrepare, c_knownPrepare, key);
             return true;
         case SignReqPacket:
@@ -81,6 +83,7 @@ public:
         switch (type)
         {
         case PrepareReqPacket:
+        case CompactPrepareReqPacket:
             return exists(x_knownPrepare, m_knownPrepare, key);
         case SignReqPacket:
             return exists(x_knownSign, m_knownSign, key);
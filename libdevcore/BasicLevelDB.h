@@ -74,6 +74,10 @@ public:
 
     virtual leveldb::Iterator* NewIterator(const leveldb::ReadOptions& _options);
 
+    /// NULL if the db is not open
+    virtual const leveldb::Snapshot* GetSnapshot();
+    virtual void ReleaseSnapshot(const leveldb::Snapshot* _snapshot);
+
     virtual std::unique_ptr<LevelDBWriteBatch> createWriteBatch() const;
 
     leveldb::Status OpenStatus() { return m_openStatus; }
@@ -0,0 +1,109 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file LRUCache.h
+ *  @author agent
+ *  @date 20261018
+ */
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace dev
+{
+/**
+ * Least recently used map bounded by the memory of its values. The caller
+ * estimates the memory of every value it puts, items are evicted from the
+ * cold end until the new one fits. Not thread safe, callers hold their lock.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache
+{
+public:
+    explicit LRUCache(size_t _capacity) : m_capacity(_capacity) {}
+
+    /// nullptr if _key is not cached, a hit becomes the most recently used item
+    Value* get(Key const& _key)
+    {
+        auto it = m_index.find(_key);
+        if (it == m_index.end())
+        {
+            return nullptr;
+        }
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return &it->second->value;
+    }
+
+    /// insert or replace, a value larger than the capacity is not cached
+    void put(Key const& _key, Value _value, size_t _memory)
+    {
+        erase(_key);
+        if (_memory > m_capacity)
+        {
+            return;
+        }
+        while (!m_lru.empty() && m_memory + _memory > m_capacity)
+        {
+            auto& last = m_lru.back();
+            m_memory -= last.memory;
+            m_index.erase(last.key);
+            m_lru.pop_back();
+        }
+        m_lru.push_front(Item{_key, std::move(_value), _memory});
+        m_index[_key] = m_lru.begin();
+        m_memory += _memory;
+    }
+
+    void erase(Key const& _key)
+    {
+        auto it = m_index.find(_key);
+        if (it != m_index.end())
+        {
+            m_memory -= it->second->memory;
+            m_lru.erase(it->second);
+            m_index.erase(it);
+        }
+    }
+
+    void clear()
+    {
+        m_lru.clear();
+        m_index.clear();
+        m_memory = 0;
+    }
+
+    size_t size() const { return m_index.size(); }
+    size_t memory() const { return m_memory; }
+    size_t capacity() const { return m_capacity; }
+
+private:
+    struct Item
+    {
+        Key key;
+        Value value;
+        size_t memory;
+    };
+
+    std::list<Item> m_lru;
+    std::unordered_map<Key, typename std::list<Item>::iterator, Hash> m_index;
+    size_t m_memory = 0;
+    size_t m_capacity;
+};
+
+}  // namespace dev
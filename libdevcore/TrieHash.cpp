@@ -18,14 +18,42 @@
 #include "TrieHash.h"
 #include "TrieCommon.h"
 #include "TrieDB.h"  // @TODO replace ASAP!
+#include "ThreadPool.h"
+#include <condition_variable>
+#include <mutex>
 
 namespace dev
 {
+/// the encoded subtrees computed ahead of the serial walk, keyed by their first key and prefix
+/// length, which identify a hash256aux call
+using SubtreeCache = std::map<std::pair<bytes const*, unsigned>, bytes>;
+
 void hash256aux(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_iterator _end,
-    unsigned _preLen, RLPStream& _rlp);
+    unsigned _preLen, RLPStream& _rlp, SubtreeCache const* _cache = nullptr);
+
+/// the number of nibbles shared by all the keys of [_begin, _end), at least _preLen
+static unsigned sharedPrefix(
+    HexMap::const_iterator _begin, HexMap::const_iterator _end, unsigned _preLen)
+{
+    // find the number of common prefix nibbles shared
+    // i.e. the minimum number of nibbles shared at the beginning between the first hex string
+    // and each successive.
+    unsigned sharedPre = (unsigned)-1;
+    for (auto i = std::next(_begin); i != _end && sharedPre; ++i)
+    {
+        unsigned x = std::min(
+            sharedPre, std::min((unsigned)_begin->first.size(), (unsigned)i->first.size()));
+        unsigned shared = _preLen;
+        for (; shared < x && _begin->first[shared] == i->first[shared]; ++shared)
+        {
+        }
+        sharedPre = std::min(shared, sharedPre);
+    }
+    return sharedPre;
+}
 
 void hash256rlp(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_iterator _end,
-    unsigned _preLen, RLPStream& _rlp)
+    unsigned _preLen, RLPStream& _rlp, SubtreeCache const* _cache = nullptr)
 {
     if (_begin == _end)
         _rlp << "";  // NULL
@@ -36,26 +64,12 @@ void hash256rlp(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_i
     }
     else
     {
-        // find the number of common prefix nibbles shared
-        // i.e. the minimum number of nibbles shared at the beginning between the first hex string
-        // and each successive.
-        unsigned sharedPre = (unsigned)-1;
-        unsigned c = 0;
-        for (auto i = std::next(_begin); i != _end && sharedPre; ++i, ++c)
-        {
-            unsigned x = std::min(
-                sharedPre, std::min((unsigned)_begin->first.size(), (unsigned)i->first.size()));
-            unsigned shared = _preLen;
-            for (; shared < x && _begin->first[shared] == i->first[shared]; ++shared)
-            {
-            }
-            sharedPre = std::min(shared, sharedPre);
-        }
+        unsigned sharedPre = sharedPrefix(_begin, _end, _preLen);
         if (sharedPre > _preLen)
         {
             // if they all have the same next nibble, we also want a pair.
             _rlp.appendList(2) << hexPrefixEncode(_begin->first, false, _preLen, (int)sharedPre);
-            hash256aux(_s, _begin, _end, (unsigned)sharedPre, _rlp);
+            hash256aux(_s, _begin, _end, (unsigned)sharedPre, _rlp, _cache);
         }
         else
         {
@@ -73,7 +87,7 @@ void hash256rlp(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_i
                 if (b == n)
                     _rlp << "";
                 else
-                    hash256aux(_s, b, n, _preLen + 1, _rlp);
+                    hash256aux(_s, b, n, _preLen + 1, _rlp, _cache);
                 b = n;
             }
             if (_preLen == _begin->first.size())
@@ -85,10 +99,19 @@ void hash256rlp(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_i
 }
 
 void hash256aux(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_iterator _end,
-    unsigned _preLen, RLPStream& _rlp)
+    unsigned _preLen, RLPStream& _rlp, SubtreeCache const* _cache)
 {
+    if (_cache)
+    {
+        auto it = _cache->find(std::make_pair(&_begin->first, _preLen));
+        if (it != _cache->end())
+        {
+            _rlp.appendRaw(it->second);
+            return;
+        }
+    }
     RLPStream rlp;
-    hash256rlp(_s, _begin, _end, _preLen, rlp);
+    hash256rlp(_s, _begin, _end, _preLen, rlp, _cache);
     if (rlp.out().size() < 32)
     {
         // RECURSIVE RLP
@@ -98,14 +121,63 @@ void hash256aux(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_i
         _rlp << sha3(rlp.out());
 }
 
+struct Subtree
+{
+    HexMap::const_iterator begin;
+    HexMap::const_iterator end;
+    unsigned preLen;
+};
+
+/// walk the nodes of [_begin, _end) the way hash256rlp does and collect the subtrees holding at
+/// most _grain keys
+static void collectSubtrees(HexMap::const_iterator _begin, HexMap::const_iterator _end,
+    unsigned _preLen, size_t _grain, std::vector<Subtree>& _subtrees)
+{
+    if (_begin == _end || std::next(_begin) == _end)
+        return;
+    unsigned sharedPre = sharedPrefix(_begin, _end, _preLen);
+    std::vector<Subtree> children;
+    if (sharedPre > _preLen)
+        children.push_back(Subtree{_begin, _end, sharedPre});
+    else
+    {
+        auto b = _begin;
+        if (_preLen == b->first.size())
+            ++b;
+        for (auto i = 0; i < 16; ++i)
+        {
+            auto n = b;
+            for (; n != _end && n->first[_preLen] == i; ++n)
+            {
+            }
+            if (b != n)
+                children.push_back(Subtree{b, n, _preLen + 1});
+            b = n;
+        }
+    }
+    for (auto const& child : children)
+    {
+        if ((size_t)std::distance(child.begin, child.end) <= _grain)
+            _subtrees.push_back(child);
+        else
+            collectSubtrees(child.begin, child.end, child.preLen, _grain, _subtrees);
+    }
+}
+
+static HexMap toHexMap(BytesMap const& _s)
+{
+    HexMap hexMap;
+    for (auto i = _s.rbegin(); i != _s.rend(); ++i)
+        hexMap[asNibbles(bytesConstRef(&i->first))] = i->second;
+    return hexMap;
+}
+
 bytes rlp256(BytesMap const& _s)
 {
     // build patricia tree.
     if (_s.empty())
         return rlp("");
-    HexMap hexMap;
-    for (auto i = _s.rbegin(); i != _s.rend(); ++i)
-        hexMap[asNibbles(bytesConstRef(&i->first))] = i->second;
+    HexMap hexMap = toHexMap(_s);
     RLPStream s;
     hash256rlp(hexMap, hexMap.cbegin(), hexMap.cend(), 0, s);
     return s.out();
@@ -116,6 +188,48 @@ h256 hash256(BytesMap const& _s)
     return sha3(rlp256(_s));
 }
 
+h256 hash256(BytesMap const& _s, ThreadPool& _pool, size_t _threads)
+{
+    if (_s.size() < c_parallelTrieThreshold || _threads < 2)
+        return hash256(_s);
+    HexMap hexMap = toHexMap(_s);
+
+    /// the subtrees are hashed on the pool, then the serial walk uses their encodings, so the
+    /// root is the same as hash256
+    std::vector<Subtree> subtrees;
+    collectSubtrees(hexMap.cbegin(), hexMap.cend(), 0,
+        std::max<size_t>(hexMap.size() / (_threads * 4), 16), subtrees);
+    std::vector<bytes> encoded(subtrees.size());
+    std::mutex lock;
+    std::condition_variable finished;
+    size_t pending = _threads;
+    for (size_t t = 0; t < _threads; ++t)
+    {
+        _pool.enqueue([&, t]() {
+            for (size_t i = t; i < subtrees.size(); i += _threads)
+            {
+                RLPStream s;
+                hash256aux(hexMap, subtrees[i].begin, subtrees[i].end, subtrees[i].preLen, s);
+                encoded[i] = s.out();
+            }
+            std::lock_guard<std::mutex> l(lock);
+            if (--pending == 0)
+                finished.notify_one();
+        });
+    }
+    {
+        std::unique_lock<std::mutex> l(lock);
+        finished.wait(l, [&]() { return pending == 0; });
+    }
+
+    SubtreeCache cache;
+    for (size_t i = 0; i < subtrees.size(); ++i)
+        cache[std::make_pair(&subtrees[i].begin->first, subtrees[i].preLen)] = std::move(encoded[i]);
+    RLPStream s;
+    hash256rlp(hexMap, hexMap.cbegin(), hexMap.cend(), 0, s, &cache);
+    return sha3(s.out());
+}
+
 h256 orderedTrieRoot(std::vector<bytes> const& _data)
 {
     BytesMap m;
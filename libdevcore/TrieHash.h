@@ -27,8 +27,16 @@
 
 namespace dev
 {
+class ThreadPool;
+
+/// maps smaller than this are hashed on the calling thread
+static const size_t c_parallelTrieThreshold = 256;
+
 bytes rlp256(BytesMap const& _s);
 h256 hash256(BytesMap const& _s);
+/// same as hash256(_s), the subtrees are hashed by _threads tasks on _pool
+/// the caller must not be a thread of _pool
+h256 hash256(BytesMap const& _s, ThreadPool& _pool, size_t _threads);
 
 h256 orderedTrieRoot(std::vector<bytes> const& _data);
 
@@ -34,6 +34,9 @@
 #include <boost/asio/ip/tcp.hpp>
 #endif
 #include "Guards.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 using namespace std;
 using namespace dev;
 
@@ -111,3 +114,371 @@ std::string dev::getThreadName()
     return g_logThreadName.m_name.get() ? *g_logThreadName.m_name.get() : "<unknown>";
 #endif
 }
+
+std::atomic<unsigned> dev::g_logLevels{~0u};
+
+namespace
+{
+/// the loggers of LOG(), fileLogger only with MultiLoggerSupport like CLOG
+std::vector<el::Logger*> logLoggers()
+{
+    std::vector<el::Logger*> loggers;
+    if (auto logger = el::Loggers::getLogger("default", false))
+    {
+        loggers.push_back(logger);
+    }
+    if (el::Loggers::hasFlag(el::LoggingFlag::MultiLoggerSupport))
+    {
+        if (auto logger = el::Loggers::getLogger("fileLogger", false))
+        {
+            loggers.push_back(logger);
+        }
+    }
+    return loggers;
+}
+
+struct LogEntry
+{
+    el::Level level;
+    const char* file;
+    unsigned long line;
+    const char* func;
+    std::string message;
+    struct timeval time;
+};
+
+/// what CLOG does for a message, _threadId is empty when logged by the calling thread
+void dispatchLog(
+    std::vector<el::Logger*> const& _loggers, LogEntry const& _entry, std::string const& _threadId)
+{
+    for (auto logger : _loggers)
+    {
+        logger->acquireLock();
+        if (logger->enabled(_entry.level))
+        {
+            el::LogMessage message(
+                _entry.level, _entry.file, _entry.line, _entry.func, 0, logger, _entry.message);
+            if (!_threadId.empty())
+            {
+                message.setOrigin(_entry.time, _threadId);
+            }
+            el::base::LogDispatcher(true, &message, el::base::DispatchAction::NormalLog)
+                .dispatch();
+        }
+        logger->releaseLock();
+    }
+}
+
+/// single producer single consumer ring of the records of a thread
+class LogRing
+{
+public:
+    LogRing() : thread(std::this_thread::get_id()), m_entries(c_capacity) {}
+
+    bool push(LogEntry& _entry)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == c_capacity)
+        {
+            return false;
+        }
+        std::swap(m_entries[tail & (c_capacity - 1)], _entry);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(LogEntry& _entry)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        std::swap(m_entries[head & (c_capacity - 1)], _entry);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::thread::id const thread;
+    /// the thread has exited, the ring is dropped once drained
+    std::atomic<bool> closed{false};
+
+private:
+    static const size_t c_capacity = 1024;
+    std::vector<LogEntry> m_entries;
+    std::atomic<size_t> m_head{0};
+    /// written by the producer only, keep it off the line of m_head
+    char m_padding[64];
+    std::atomic<size_t> m_tail{0};
+};
+
+struct LogRingHolder
+{
+    ~LogRingHolder()
+    {
+        if (ring)
+        {
+            ring->closed = true;
+        }
+    }
+    std::shared_ptr<LogRing> ring;
+};
+
+class AsyncLogState
+{
+public:
+    ~AsyncLogState() { stop(); }
+
+    void start()
+    {
+        std::lock_guard<std::mutex> l(m_startLock);
+        if (m_running)
+        {
+            return;
+        }
+        m_exit = false;
+        m_running = true;
+        m_thread = std::thread([this]() { run(); });
+    }
+
+    void stop()
+    {
+        std::lock_guard<std::mutex> l(m_startLock);
+        if (!m_running)
+        {
+            return;
+        }
+        m_running = false;
+        m_exit = true;
+        m_thread.join();
+        // records pushed while the writer was exiting
+        drain();
+    }
+
+    bool running() const { return m_running.load(std::memory_order_relaxed); }
+
+    void push(LogEntry& _entry)
+    {
+        static thread_local LogRingHolder holder;
+        if (!holder.ring)
+        {
+            holder.ring = std::make_shared<LogRing>();
+            std::lock_guard<std::mutex> l(m_ringsLock);
+            m_newRings.push_back(holder.ring);
+        }
+        // the writer is behind, wait for it instead of dropping records
+        while (!holder.ring->push(_entry))
+        {
+            if (!running())
+            {
+                dispatchLog(logLoggers(), _entry, std::string());
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void flush()
+    {
+        if (!running())
+        {
+            return;
+        }
+        uint64_t request = ++m_flushRequest;
+        while (m_flushDone.load() < request && running())
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+private:
+    void run()
+    {
+        dev::pthread_setThreadName("log");
+        while (!m_exit)
+        {
+            if (!drain())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        drain();
+    }
+
+    /// writes the records of all rings, false if there were none
+    bool drain()
+    {
+        uint64_t request = m_flushRequest.load();
+        {
+            std::lock_guard<std::mutex> l(m_ringsLock);
+            m_rings.insert(m_rings.end(), m_newRings.begin(), m_newRings.end());
+            m_newRings.clear();
+        }
+
+        bool written = false;
+        std::vector<el::Logger*> loggers;
+        LogEntry entry;
+        for (auto it = m_rings.begin(); it != m_rings.end();)
+        {
+            auto& ring = *it;
+            // checked before draining, so that a record pushed before closing is written
+            bool closed = ring->closed;
+            while (ring->pop(entry))
+            {
+                if (!written)
+                {
+                    loggers = logLoggers();
+                    written = true;
+                }
+                dispatchLog(loggers, entry, threadId(ring->thread));
+            }
+            if (closed)
+            {
+                m_threadIds.erase(ring->thread);
+                it = m_rings.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        m_flushDone = request;
+        return written;
+    }
+
+    std::string const& threadId(std::thread::id _thread)
+    {
+        auto it = m_threadIds.find(_thread);
+        if (it == m_threadIds.end())
+        {
+            std::stringstream ss;
+            ss << _thread;
+            it = m_threadIds.emplace(_thread, ss.str()).first;
+        }
+        return it->second;
+    }
+
+    std::mutex m_startLock;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_exit{false};
+    std::thread m_thread;
+
+    std::mutex m_ringsLock;
+    std::vector<std::shared_ptr<LogRing>> m_newRings;
+    /// used by the writer only
+    std::vector<std::shared_ptr<LogRing>> m_rings;
+    std::unordered_map<std::thread::id, std::string> m_threadIds;
+
+    std::atomic<uint64_t> m_flushRequest{0};
+    std::atomic<uint64_t> m_flushDone{0};
+};
+
+AsyncLogState& asyncLogState()
+{
+    static AsyncLogState state;
+    return state;
+}
+
+/// the stream of the thread, reused by its LOG() statements
+struct LogBuffer
+{
+    std::ostringstream stream;
+    bool busy = false;
+};
+thread_local LogBuffer t_logBuffer;
+}  // namespace
+
+void dev::refreshLogLevels()
+{
+    unsigned levels = 0;
+    for (auto logger : logLoggers())
+    {
+        logger->acquireLock();
+        el::base::type::EnumType level = el::LevelHelper::kMinValid;
+        el::LevelHelper::forEachLevel(&level, [&]() -> bool {
+            // fileLogger is enabled but writes nowhere
+            auto l = el::LevelHelper::castFromInt(level);
+            auto config = logger->typedConfigurations();
+            if (logger->enabled(l) && (config->toFile(l) || config->toStandardOutput(l)))
+            {
+                levels |= level;
+            }
+            return false;
+        });
+        logger->releaseLock();
+    }
+    g_logLevels = levels;
+}
+
+LogRecord::LogRecord(el::Level _level, const char* _file, unsigned long _line, const char* _func)
+  : m_level(_level), m_file(_file), m_line(_line), m_func(_func)
+{
+    el::base::utils::DateTime::gettimeofday(&m_time);
+    if (!t_logBuffer.busy)
+    {
+        t_logBuffer.busy = true;
+        auto& stream = t_logBuffer.stream;
+        stream.str(std::string());
+        stream.clear();
+        stream.flags(std::ios_base::dec | std::ios_base::skipws);
+        stream.precision(6);
+        stream.width(0);
+        stream.fill(' ');
+        m_stream = &stream;
+    }
+    else
+    {
+        m_nested.reset(new std::ostringstream);
+        m_stream = m_nested.get();
+    }
+}
+
+LogRecord::~LogRecord()
+{
+    LogEntry entry{m_level, m_file, m_line, m_func, std::string(), m_time};
+    if (m_nested)
+    {
+        entry.message = m_nested->str();
+    }
+    else
+    {
+        entry.message = t_logBuffer.stream.str();
+        t_logBuffer.busy = false;
+    }
+
+    auto& state = asyncLogState();
+    if (m_level == el::Level::Fatal)
+    {
+        // written at once with CLOG, which aborts the process
+        state.flush();
+        CLOG(FATAL, "default", "fileLogger") << entry.message;
+    }
+    else if (state.running())
+    {
+        state.push(entry);
+    }
+    else
+    {
+        dispatchLog(logLoggers(), entry, std::string());
+    }
+}
+
+void AsyncLogWriter::start()
+{
+    asyncLogState().start();
+}
+
+void AsyncLogWriter::stop()
+{
+    asyncLogState().stop();
+}
+
+void AsyncLogWriter::flush()
+{
+    asyncLogState().flush();
+}
+
+bool AsyncLogWriter::running()
+{
+    return asyncLogState().running();
+}
@@ -29,10 +29,13 @@
 #include "FixedHash.h"
 #include "easylogging++.h"
 #include "vector_ref.h"
+#include <atomic>
 #include <chrono>
 #include <ctime>
 //#include "Terminal.h"
 #include <map>
+#include <memory>
+#include <sstream>
 #include <string>
 namespace dev
 {
@@ -51,11 +54,82 @@ void pthread_setThreadName(std::string const& _n);
 
 /// Set the current thread's log name.
 std::string getThreadName();
+
+/// el::Level flags of the levels the "default" or "fileLogger" logger writes, LOG() of the
+/// other levels does not evaluate its arguments
+extern std::atomic<unsigned> g_logLevels;
+
+inline bool logEnabled(el::Level _level)
+{
+    return g_logLevels.load(std::memory_order_relaxed) & static_cast<unsigned>(_level);
+}
+
+/// reload g_logLevels after the loggers are reconfigured, all levels are enabled until then
+void refreshLogLevels();
+
+/**
+ * One statement of LOG(): the arguments are streamed into a buffer of the
+ * thread, and the message is handed to the AsyncLogWriter (or dispatched to
+ * easylogging++ at once if it is not running) when the statement ends.
+ */
+class LogRecord
+{
+public:
+    LogRecord(el::Level _level, const char* _file, unsigned long _line, const char* _func);
+    ~LogRecord();
+
+    std::ostream& stream() { return *m_stream; }
+
+private:
+    el::Level m_level;
+    const char* m_file;
+    unsigned long m_line;
+    const char* m_func;
+    struct timeval m_time;
+    std::ostream* m_stream;
+    /// the stream of a LOG() evaluated while streaming the arguments of another one
+    std::unique_ptr<std::ostringstream> m_nested;
+};
+
+/// makes the LOG() expression void, & binds looser than <<
+struct LogVoidify
+{
+    void operator&(std::ostream&) {}
+};
+
+/**
+ * Background writer of the log records. Every logging thread pushes its
+ * records into its own single producer ring buffer without taking a lock,
+ * the writer thread drains the rings and dispatches the records to
+ * easylogging++, which formats them with the time and thread they were
+ * logged at, writes the files and rolls them as before.
+ */
+class AsyncLogWriter
+{
+public:
+    static void start();
+    /// writes the pending records and returns to synchronous logging
+    static void stop();
+    /// returns after the records logged before the call are written
+    static void flush();
+    static bool running();
+};
 }  // namespace dev
 
+#define DEV_LOG_LEVEL_TRACE el::Level::Trace
+#define DEV_LOG_LEVEL_DEBUG el::Level::Debug
+#define DEV_LOG_LEVEL_INFO el::Level::Info
+#define DEV_LOG_LEVEL_WARNING el::Level::Warning
+#define DEV_LOG_LEVEL_ERROR el::Level::Error
+#define DEV_LOG_LEVEL_FATAL el::Level::Fatal
+
 #define MY_CUSTOM_LOGGER(LEVEL) CLOG(LEVEL, "default", "fileLogger")
 #undef LOG
-#define LOG(LEVEL) CLOG(LEVEL, "default", "fileLogger")
+#define LOG(LEVEL)                                                                  \
+    !dev::logEnabled(DEV_LOG_LEVEL_##LEVEL) ?                                       \
+        (void)0 :                                                                   \
+        dev::LogVoidify() &                                                         \
+            dev::LogRecord(DEV_LOG_LEVEL_##LEVEL, __FILE__, __LINE__, ELPP_FUNC).stream()
 #undef VLOG
 #define VLOG(LEVEL) CVLOG(LEVEL, "default", "fileLogger")
 #define LOGCOMWARNING LOG(WARNING) << "common|"
@@ -2944,14 +2944,20 @@ base::type::string_t DefaultLogBuilder::build(
     {
         // Thread ID
         base::utils::Str::replaceFirstWithEscape(logLine, base::consts::kThreadIdFormatSpecifier,
-            ELPP->getThreadName(base::threading::getCurrentThreadId()));
+            ELPP->getThreadName(logMessage->hasOrigin() ?
+                                    logMessage->threadId() :
+                                    base::threading::getCurrentThreadId()));
     }
     if (logFormat->hasFlag(base::FormatFlags::DateTime))
     {
         // DateTime
         base::utils::Str::replaceFirstWithEscape(logLine, base::consts::kDateTimeFormatSpecifier,
-            base::utils::DateTime::getDateTime(
-                logFormat->dateTimeFormat().c_str(), &tc->subsecondPrecision(logMessage->level())));
+            logMessage->hasOrigin() ?
+                base::utils::DateTime::timevalToString(logMessage->time(),
+                    logFormat->dateTimeFormat().c_str(),
+                    &tc->subsecondPrecision(logMessage->level())) :
+                base::utils::DateTime::getDateTime(logFormat->dateTimeFormat().c_str(),
+                    &tc->subsecondPrecision(logMessage->level())));
     }
     if (logFormat->hasFlag(base::FormatFlags::Function))
     {
@@ -2642,7 +2642,20 @@ public:
         m_func(func),
         m_verboseLevel(verboseLevel),
         m_logger(logger),
-        m_message(logger->stream().str())
+        m_message(logger->stream().str()),
+        m_hasTime(false)
+    {}
+    LogMessage(Level level, const std::string& file, base::type::LineNumber line,
+        const std::string& func, base::type::VerboseLevel verboseLevel, Logger* logger,
+        const base::type::string_t& message)
+      : m_level(level),
+        m_file(file),
+        m_line(line),
+        m_func(func),
+        m_verboseLevel(verboseLevel),
+        m_logger(logger),
+        m_message(message),
+        m_hasTime(false)
     {}
     inline Level level(void) const { return m_level; }
     inline const std::string& file(void) const { return m_file; }
@@ -2652,6 +2665,18 @@ public:
     inline Logger* logger(void) const { return m_logger; }
     inline const base::type::string_t& message(void) const { return m_message; }
 
+    /// @brief Time and thread of a message that is dispatched later by another thread, %datetime
+    /// and %thread use them instead of the dispatching time and thread
+    inline void setOrigin(const struct timeval& time, const std::string& threadId)
+    {
+        m_time = time;
+        m_threadId = threadId;
+        m_hasTime = true;
+    }
+    inline bool hasOrigin(void) const { return m_hasTime; }
+    inline const struct timeval& time(void) const { return m_time; }
+    inline const std::string& threadId(void) const { return m_threadId; }
+
 private:
     Level m_level;
     std::string m_file;
@@ -2660,6 +2685,9 @@ private:
     base::type::VerboseLevel m_verboseLevel;
     Logger* m_logger;
     base::type::string_t m_message;
+    bool m_hasTime;
+    struct timeval m_time;
+    std::string m_threadId;
 };
 namespace base
 {
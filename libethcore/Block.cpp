@@ -24,19 +24,101 @@
 #include "Block.h"
 #include <libdevcore/Guards.h>
 #include <libdevcore/RLP.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/easylog.h>
+#include <condition_variable>
+#include <exception>
+#include <thread>
 namespace dev
 {
 namespace eth
 {
-Block::Block(bytesConstRef _data)
+namespace
 {
-    decode(_data);
+/// the transactions and receipts of larger blocks are encoded and hashed in parallel
+size_t const c_parallelEncodeThreshold = 256;
+
+size_t encodeThreads()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/// shared by the blocks, the callers are never threads of the pool
+ThreadPool& encodePool()
+{
+    static ThreadPool pool("BlockEncode", encodeThreads());
+    return pool;
+}
+
+/// encode the items, then build the rlp list and the trie root of the encoded items,
+/// the same as encoding and inserting them one by one
+template <class T>
+void encodeAndHash(std::vector<T> const& _items, bytes& _listOut, h256& _root)
+{
+    std::vector<bytes> encoded(_items.size());
+    size_t threads = encodeThreads();
+    if (_items.size() < c_parallelEncodeThreshold || threads < 2)
+    {
+        for (size_t i = 0; i < _items.size(); i++)
+            _items[i].encode(encoded[i]);
+    }
+    else
+    {
+        std::mutex lock;
+        std::condition_variable finished;
+        size_t pending = threads;
+        std::exception_ptr error;
+        for (size_t t = 0; t < threads; t++)
+        {
+            encodePool().enqueue([&, t]() {
+                std::exception_ptr taskError;
+                try
+                {
+                    for (size_t i = t; i < _items.size(); i += threads)
+                        _items[i].encode(encoded[i]);
+                }
+                catch (...)
+                {
+                    taskError = std::current_exception();
+                }
+                std::lock_guard<std::mutex> l(lock);
+                if (taskError)
+                    error = taskError;
+                if (--pending == 0)
+                    finished.notify_one();
+            });
+        }
+        std::unique_lock<std::mutex> l(lock);
+        finished.wait(l, [&]() { return pending == 0; });
+        /// the same exception as encoding on the calling thread, e.g. an unsigned transaction
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    RLPStream list;
+    list.appendList(encoded.size());
+    BytesMap mapCache;
+    for (size_t i = 0; i < encoded.size(); i++)
+    {
+        list.appendRaw(encoded[i]);
+        mapCache.insert(std::make_pair(rlp(i), std::move(encoded[i])));
+    }
+    list.swapOut(_listOut);
+    if (mapCache.size() < c_parallelEncodeThreshold || threads < 2)
+        _root = hash256(mapCache);
+    else
+        _root = hash256(mapCache, encodePool(), threads);
+}
+}  // namespace
+
+Block::Block(bytesConstRef _data, CheckTransaction const _checkSig)
+{
+    decode(_data, _checkSig);
 }
 
-Block::Block(bytes const& _data)
+Block::Block(bytes const& _data, CheckTransaction const _checkSig)
 {
-    decode(ref(_data));
+    decode(ref(_data), _checkSig);
 }
 
 Block::Block(Block const& _block)
@@ -99,22 +181,9 @@ void Block::encode(bytes& _out) const
 void Block::calTransactionRoot(bool update) const
 {
     WriteGuard l(x_txsCache);
-    RLPStream txs;
-    txs.appendList(m_transactions.size());
     if (m_txsCache == bytes())
     {
-        BytesMap txsMapCache;
-        for (size_t i = 0; i < m_transactions.size(); i++)
-        {
-            RLPStream s;
-            s << i;
-            bytes trans_data;
-            m_transactions[i].encode(trans_data);
-            txs.appendRaw(trans_data);
-            txsMapCache.insert(std::make_pair(s.out(), trans_data));
-        }
-        txs.swapOut(m_txsCache);
-        m_transRootCache = hash256(txsMapCache);
+        encodeAndHash(m_transactions, m_txsCache, m_transRootCache);
     }
     if (update == true)
         m_blockHeader.setTransactionsRoot(m_transRootCache);
@@ -126,20 +195,7 @@ void Block::calReceiptRoot(bool update) const
     WriteGuard l(x_txReceiptsCache);
     if (m_tReceiptsCache == bytes())
     {
-        RLPStream txReceipts;
-        txReceipts.appendList(m_transactionReceipts.size());
-        BytesMap mapCache;
-        for (size_t i = 0; i < m_transactionReceipts.size(); i++)
-        {
-            RLPStream s;
-            s << i;
-            bytes tranReceipts_data;
-            m_transactionReceipts[i].encode(tranReceipts_data);
-            txReceipts.appendRaw(tranReceipts_data);
-            mapCache.insert(std::make_pair(s.out(), tranReceipts_data));
-        }
-        txReceipts.swapOut(m_tReceiptsCache);
-        m_receiptRootCache = hash256(mapCache);
+        encodeAndHash(m_transactionReceipts, m_tReceiptsCache, m_receiptRootCache);
     }
     if (update == true)
     {
@@ -151,7 +207,7 @@ void Block::calReceiptRoot(bool update) const
  * @brief : decode specified data of block into Block class
  * @param _block : the specified data of block
  */
-void Block::decode(bytesConstRef _block_bytes)
+void Block::decode(bytesConstRef _block_bytes, CheckTransaction const _checkSig)
 {
     /// no try-catch to throw exceptions directly
     /// get RLP of block
@@ -163,7 +219,7 @@ void Block::decode(bytesConstRef _block_bytes)
     m_transactions.resize(transactions_rlp.itemCount());
     for (size_t i = 0; i < transactions_rlp.itemCount(); i++)
     {
-        m_transactions[i].decode(transactions_rlp[i]);
+        m_transactions[i].decode(transactions_rlp[i], _checkSig);
     }
     /// get transactionReceipt list
     RLP transactionReceipts_rlp = block_rlp[2];
@@ -37,8 +37,10 @@ class Block
 public:
     ///-----constructors of Block
     Block() = default;
-    explicit Block(bytesConstRef _data);
-    explicit Block(bytes const& _data);
+    explicit Block(
+        bytesConstRef _data, CheckTransaction const _checkSig = CheckTransaction::Everything);
+    explicit Block(
+        bytes const& _data, CheckTransaction const _checkSig = CheckTransaction::Everything);
     /// copy constructor
     Block(Block const& _block);
     /// assignment operator
@@ -65,7 +67,10 @@ public:
     void encode(bytes& _out) const;
 
     ///-----decode functions
-    void decode(bytesConstRef _block);
+    /// blocks read from the local storage have been verified, they are decoded with
+    /// CheckTransaction::None and the senders are recovered when they are needed
+    void decode(
+        bytesConstRef _block, CheckTransaction const _checkSig = CheckTransaction::Everything);
 
     /// @returns the RLP serialisation of this block.
     bytes rlp() const
@@ -110,6 +115,12 @@ public:
             m_transactions.push_back(trans);
         noteChange();
     }
+    /// set the known senders of the transactions, instead of recovering them
+    void setSenders(std::vector<Address> const& _senders)
+    {
+        for (size_t i = 0; i < _senders.size() && i < m_transactions.size(); i++)
+            m_transactions[i].forceSender(_senders[i]);
+    }
     /// set block header
     void setBlockHeader(BlockHeader const& _blockHeader) { m_blockHeader = _blockHeader; }
     /// set sig list
@@ -135,6 +135,10 @@ public:
     /// @param _commitBehaviour whether or not to remove empty accounts during commit.
     virtual void commit() = 0;
 
+    /// Finish the changes of a transaction. States which can commit once per block keep them
+    /// in the cache until commit(), rootHash() is not updated before that.
+    virtual void commitTransaction() { commit(); }
+
     /// Commit levelDB data into hardisk or commit AMDB data into database (Called after commit())
     /// @param _commitBehaviour whether or not to remove empty accounts during commit.
     virtual void dbCommit(h256 const& _blockHash, int64_t _blockNumber) = 0;
@@ -159,6 +163,9 @@ public:
 
     /// Check authority
     virtual bool checkAuthority(Address const& _origin, Address const& _contract) const = 0;
+
+    /// Load the accounts into the caches before they are used, states may ignore the hint
+    virtual void prefetch(std::vector<Address> const&) {}
 };
 
 }  // namespace executive
@@ -124,4 +124,10 @@ void LogInitializer::initEasylogging(boost::property_tree::ptree const& pt)
     el::Loggers::reconfigureLogger("default", allConf);
     el::Loggers::reconfigureLogger(fileLogger, defaultConf);
     el::Helpers::installPreRollOutCallback(rolloutHandler);
+    dev::refreshLogLevels();
+    /// write the logs in a background thread
+    if (pt.get<bool>("log.ASYNC-ENABLED", true))
+    {
+        dev::AsyncLogWriter::start();
+    }
 }
@@ -0,0 +1,77 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file AnalysedCodeCache.cpp
+ *  @author agent
+ *  @date 20261018
+ */
+
+#include "AnalysedCodeCache.h"
+
+using namespace dev;
+using namespace dev::eth;
+
+AnalysedCodeCache& AnalysedCodeCache::instance()
+{
+    static AnalysedCodeCache cache(c_defaultCapacity);
+    return cache;
+}
+
+AnalysedCode::Ptr AnalysedCodeCache::get(h256 const& _codeHash)
+{
+    Guard l(m_lock);
+    auto code = m_cache.get(_codeHash);
+    if (!code)
+    {
+        ++m_miss;
+        return nullptr;
+    }
+    ++m_hit;
+    return *code;
+}
+
+void AnalysedCodeCache::put(h256 const& _codeHash, AnalysedCode::Ptr _code)
+{
+    size_t memory = estimateMemory(*_code);
+    Guard l(m_lock);
+    m_cache.put(_codeHash, _code, memory);
+}
+
+void AnalysedCodeCache::clear()
+{
+    Guard l(m_lock);
+    m_cache.clear();
+}
+
+AnalysedCodeCache::Stats AnalysedCodeCache::stats() const
+{
+    Stats stats;
+    stats.hit = m_hit.load();
+    stats.miss = m_miss.load();
+    Guard l(m_lock);
+    stats.capacity = m_cache.capacity();
+    stats.size = m_cache.size();
+    stats.memory = m_cache.memory();
+    return stats;
+}
+
+size_t AnalysedCodeCache::estimateMemory(AnalysedCode const& _code)
+{
+    /// the AnalysedCode object with its three vector headers, plus the cache bookkeeping
+    const size_t c_overhead = 128;
+    return _code.code.size() + _code.pool.size() * sizeof(u256) +
+           _code.jumpDests.size() * sizeof(uint64_t) + c_overhead;
+}
@@ -0,0 +1,88 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file AnalysedCodeCache.h
+ *  @author agent
+ *  @date 20261018
+ */
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <libdevcore/LRUCache.h>
+#include <atomic>
+#include <memory>
+
+namespace dev
+{
+namespace eth
+{
+/// contract code with the interpreter optimizations applied, it depends on the code only, so
+/// the VMs running the same code share it and never modify it
+struct AnalysedCode
+{
+    typedef std::shared_ptr<AnalysedCode const> Ptr;
+
+    /// the code extended with zero bytes, synthetic opcodes replaced
+    bytes code;
+    /// constant pool of PUSHC
+    std::vector<u256> pool;
+    /// sorted positions of JUMPDEST
+    std::vector<uint64_t> jumpDests;
+};
+
+/**
+ * Bounded LRU cache of AnalysedCode keyed by code hash, shared by all the
+ * interpreters of the process, so that a hot contract is analysed once
+ * instead of on every call.
+ */
+class AnalysedCodeCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hit = 0;
+        uint64_t miss = 0;
+        uint64_t size = 0;      ///< cached codes
+        uint64_t memory = 0;    ///< estimated bytes held by the cache
+        uint64_t capacity = 0;  ///< memory limit in bytes
+    };
+
+    explicit AnalysedCodeCache(size_t _capacity) : m_cache(_capacity) {}
+
+    static AnalysedCodeCache& instance();
+
+    /// nullptr if the code is not cached
+    AnalysedCode::Ptr get(h256 const& _codeHash);
+    void put(h256 const& _codeHash, AnalysedCode::Ptr _code);
+    void clear();
+    Stats stats() const;
+
+    static const size_t c_defaultCapacity = 64 * 1024 * 1024;
+
+private:
+    static size_t estimateMemory(AnalysedCode const& _code);
+
+    mutable Mutex m_lock;
+    LRUCache<h256, AnalysedCode::Ptr> m_cache;
+
+    std::atomic<uint64_t> m_hit = {0};
+    std::atomic<uint64_t> m_miss = {0};
+};
+
+}  // namespace eth
+}  // namespace dev
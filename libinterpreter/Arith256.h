@@ -0,0 +1,250 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file Arith256.h
+ *  @author agent
+ *  @date 20261018
+ *
+ * Fixed width 256-bit kernels for the interpreter opcodes. The stack keeps
+ * u256, the kernels read its limbs into four 64-bit words, compute with
+ * straight line code (carries and products through unsigned __int128, so
+ * the compiler emits adc/sbb and mul/mulx) and write the limbs back.
+ * When EVM_FIXED_WIDTH_ARITH is off (no __int128) every kernel falls back
+ * to the boost::multiprecision operators.
+ *
+ * Unsigned comparisons and right shifts are left to boost, which already
+ * compares the limb counts first and is faster than a full load there.
+ */
+#pragma once
+
+#include "VMConfig.h"
+#include <libdevcore/Common.h>
+#include <cstring>
+
+namespace dev
+{
+namespace eth
+{
+namespace arith256
+{
+#if EVM_FIXED_WIDTH_ARITH
+
+typedef unsigned __int128 uint128;
+static_assert(sizeof(boost::multiprecision::limb_type) == sizeof(uint64_t),
+    "fixed width arithmetic needs 64-bit limbs");
+
+/// little endian 64-bit limbs
+struct Word
+{
+    uint64_t w[4];
+};
+
+/// the backend stores the 4 limbs inline and keeps the count of the used ones,
+/// the unused ones are masked instead of branching on the count
+inline Word load(u256 const& _v)
+{
+    auto const& backend = _v.backend();
+    auto limbs = backend.limbs();
+    unsigned size = backend.size();
+    Word r;
+    for (unsigned i = 0; i < 4; ++i)
+        r.w[i] = limbs[i] & -(uint64_t)(i < size);
+    return r;
+}
+
+inline void store(u256& _r, Word const& _a)
+{
+    auto& backend = _r.backend();
+    unsigned size = _a.w[3] ? 4 : _a.w[2] ? 3 : _a.w[1] ? 2 : 1;
+    backend.resize(size, size);
+    std::memcpy(backend.limbs(), _a.w, sizeof(_a.w));
+}
+
+inline Word add(Word const& _a, Word const& _b)
+{
+    Word r;
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint128 s = (uint128)_a.w[i] + _b.w[i] + carry;
+        r.w[i] = (uint64_t)s;
+        carry = (uint64_t)(s >> 64);
+    }
+    return r;
+}
+
+inline Word sub(Word const& _a, Word const& _b)
+{
+    Word r;
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint128 d = (uint128)_a.w[i] - _b.w[i] - borrow;
+        r.w[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    return r;
+}
+
+/// product mod 2^256, only the 10 partial products below 2^256 are computed
+inline Word mul(Word const& _a, Word const& _b)
+{
+    Word r;
+    uint128 p;
+    uint64_t r1, r2, r3;
+
+    p = (uint128)_a.w[0] * _b.w[0];
+    r.w[0] = (uint64_t)p;
+    p = (uint128)_a.w[0] * _b.w[1] + (uint64_t)(p >> 64);
+    r1 = (uint64_t)p;
+    p = (uint128)_a.w[0] * _b.w[2] + (uint64_t)(p >> 64);
+    r2 = (uint64_t)p;
+    r3 = _a.w[0] * _b.w[3] + (uint64_t)(p >> 64);
+
+    p = (uint128)_a.w[1] * _b.w[0] + r1;
+    r.w[1] = (uint64_t)p;
+    p = (uint128)_a.w[1] * _b.w[1] + r2 + (uint64_t)(p >> 64);
+    r2 = (uint64_t)p;
+    r3 += _a.w[1] * _b.w[2] + (uint64_t)(p >> 64);
+
+    p = (uint128)_a.w[2] * _b.w[0] + r2;
+    r.w[2] = (uint64_t)p;
+    r3 += _a.w[2] * _b.w[1] + (uint64_t)(p >> 64);
+
+    r.w[3] = r3 + _a.w[3] * _b.w[0];
+    return r;
+}
+
+inline bool lt(Word const& _a, Word const& _b)
+{
+    // the borrow out of _a - _b
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint128 d = (uint128)_a.w[i] - _b.w[i] - borrow;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    return borrow != 0;
+}
+
+inline bool slt(Word const& _a, Word const& _b)
+{
+    bool aNeg = _a.w[3] >> 63;
+    bool bNeg = _b.w[3] >> 63;
+    // same sign: two's complement order is the unsigned order
+    return aNeg != bNeg ? aNeg : lt(_a, _b);
+}
+
+/// _shift < 256
+inline Word shl(Word const& _a, unsigned _shift)
+{
+    Word r = {{0, 0, 0, 0}};
+    unsigned limbs = _shift / 64;
+    unsigned bits = _shift % 64;
+    for (unsigned i = limbs; i < 4; ++i)
+    {
+        r.w[i] = _a.w[i - limbs] << bits;
+        if (bits && i > limbs)
+            r.w[i] |= _a.w[i - limbs - 1] >> (64 - bits);
+    }
+    return r;
+}
+
+/// exponentiation by squaring on the words, without normalization in between
+inline Word exp(Word _base, Word const& _exponent)
+{
+    Word r = {{1, 0, 0, 0}};
+    int top = 3;
+    while (top >= 0 && _exponent.w[top] == 0)
+        --top;
+    for (int i = 0; i <= top; ++i)
+    {
+        uint64_t e = _exponent.w[i];
+        // all the bits of the lower limbs, up to the highest set bit of the top one
+        for (int bit = 0; bit < 64 && (e || i < top); ++bit, e >>= 1)
+        {
+            if (e & 1)
+                r = mul(r, _base);
+            _base = mul(_base, _base);
+        }
+    }
+    return r;
+}
+
+inline void add(u256& _r, u256 const& _a, u256 const& _b)
+{
+    store(_r, add(load(_a), load(_b)));
+}
+inline void sub(u256& _r, u256 const& _a, u256 const& _b)
+{
+    store(_r, sub(load(_a), load(_b)));
+}
+inline void mul(u256& _r, u256 const& _a, u256 const& _b)
+{
+    store(_r, mul(load(_a), load(_b)));
+}
+inline void exp(u256& _r, u256 const& _base, u256 const& _exponent)
+{
+    store(_r, exp(load(_base), load(_exponent)));
+}
+inline bool slt(u256 const& _a, u256 const& _b)
+{
+    return slt(load(_a), load(_b));
+}
+inline void shl(u256& _r, u256 const& _a, unsigned _shift)
+{
+    store(_r, shl(load(_a), _shift));
+}
+
+#else
+
+inline void add(u256& _r, u256 const& _a, u256 const& _b)
+{
+    _r = _a + _b;
+}
+inline void sub(u256& _r, u256 const& _a, u256 const& _b)
+{
+    _r = _a - _b;
+}
+inline void mul(u256& _r, u256 const& _a, u256 const& _b)
+{
+    _r = _a * _b;
+}
+inline void exp(u256& _r, u256 _base, u256 _exponent)
+{
+    u256 result = 1;
+    while (_exponent)
+    {
+        if (static_cast<boost::multiprecision::limb_type>(_exponent) & 1)
+            result *= _base;
+        _base *= _base;
+        _exponent >>= 1;
+    }
+    _r = result;
+}
+inline bool slt(u256 const& _a, u256 const& _b)
+{
+    return u2s(_a) < u2s(_b);
+}
+inline void shl(u256& _r, u256 const& _a, unsigned _shift)
+{
+    _r = _a << _shift;
+}
+
+#endif
+}  // namespace arith256
+}  // namespace eth
+}  // namespace dev
@@ -557,8 +557,7 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            u256 base = m_SP[0];
-            m_SPP[0] = exp256(base, expon);
+            arith256::exp(m_SPP[0], m_SP[0], expon);
         }
         NEXT
 
@@ -572,7 +571,7 @@ void VM::interpretCases()
             updateIOGas();
 
             // pops two items and pushes their sum mod 2^256.
-            m_SPP[0] = m_SP[0] + m_SP[1];
+            arith256::add(m_SPP[0], m_SP[0], m_SP[1]);
         }
         NEXT
 
@@ -582,7 +581,7 @@ void VM::interpretCases()
             updateIOGas();
 
             // pops two items and pushes their product mod 2^256.
-            m_SPP[0] = m_SP[0] * m_SP[1];
+            arith256::mul(m_SPP[0], m_SP[0], m_SP[1]);
         }
         NEXT
 
@@ -591,7 +590,7 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_SP[0] - m_SP[1];
+            arith256::sub(m_SPP[0], m_SP[0], m_SP[1]);
         }
         NEXT
 
@@ -664,7 +663,7 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = u2s(m_SP[0]) < u2s(m_SP[1]) ? 1 : 0;
+            m_SPP[0] = arith256::slt(m_SP[0], m_SP[1]) ? 1 : 0;
         }
         NEXT
 
@@ -673,7 +672,7 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = u2s(m_SP[0]) > u2s(m_SP[1]) ? 1 : 0;
+            m_SPP[0] = arith256::slt(m_SP[1], m_SP[0]) ? 1 : 0;
         }
         NEXT
 
@@ -743,7 +742,7 @@ void VM::interpretCases()
             if (m_SP[0] >= 256)
                 m_SPP[0] = 0;
             else
-                m_SPP[0] = m_SP[1] << unsigned(m_SP[0]);
+                arith256::shl(m_SPP[0], m_SP[1], unsigned(m_SP[0]));
         }
         NEXT
 
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include "AnalysedCodeCache.h"
+#include "Arith256.h"
 #include "VMConfig.h"
 
 #include <libdevcore/Common.h>
@@ -83,8 +85,7 @@ private:
 
     static std::array<evmc_instruction_metrics, 256> c_metrics;
     static void initMetrics();
-    static u256 exp256(u256 _base, u256 _exponent);
-    void copyCode(int);
+    static void copyCode(bytes& _code, uint8_t const* _src, size_t _size, int _extraBytes);
     typedef void (VM::*MemFnPtr)();
     MemFnPtr m_bounce = nullptr;
     uint64_t m_nSteps = 0;
@@ -97,8 +98,11 @@ private:
 
     uint8_t const* m_pCode = nullptr;
     size_t m_codeSize = 0;
-    // space for code
-    bytes m_code;
+    // analysed code, shared with the other VMs running the same code
+    AnalysedCode::Ptr m_analysed;
+    // zero bytes appended to the code to read PUSH data without bounds checks
+    static const int c_extraCodeBytes = 33;
+    byte const* m_code = nullptr;
 
     /// RETURNDATA buffer for memory returned from direct subcalls.
     bytes m_returnData;
@@ -109,7 +113,7 @@ private:
     size_t stackSize() { return m_stackEnd - m_SP; }
 
     // constant pool
-    std::vector<u256> m_pool;
+    u256 const* m_pool = nullptr;
 
     // interpreter state
     Instruction m_OP;         // current operation
@@ -125,6 +129,7 @@ private:
     // initialize interpreter
     void initEntry();
     void optimize();
+    static AnalysedCode::Ptr analyse(uint8_t const* _code, size_t _size);
 
     // interpreter loop & switch
     void interpretCases();
@@ -148,8 +153,8 @@ private:
     void throwBufferOverrun(bigint const& _enfOfAccess);
 
     std::vector<uint64_t> m_beginSubs;
-    std::vector<uint64_t> m_jumpDests;
     int64_t verifyJumpDest(u256 const& _dest, bool _throw = true);
+    static int64_t findJumpDest(std::vector<uint64_t> const& _jumpDests, u256 const& _dest);
 
     void onOperation() {}
     void adjustStack(int _removed, int _added);
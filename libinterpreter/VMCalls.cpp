@@ -90,7 +90,7 @@ void VM::throwBufferOverrun(bigint const& _endOfAccess)
         BufferOverrun() << RequirementError(_endOfAccess, bigint(m_returnData.size())));
 }
 
-int64_t VM::verifyJumpDest(u256 const& _dest, bool _throw)
+int64_t VM::findJumpDest(std::vector<uint64_t> const& _jumpDests, u256 const& _dest)
 {
     // check for overflow
     if (_dest <= 0x7FFFFFFFFFFFFFFF)
@@ -98,14 +98,20 @@ int64_t VM::verifyJumpDest(u256 const& _dest, bool _throw)
         // check for within bounds and to a jump destination
         // use binary search of array because hashtable collisions are exploitable
         uint64_t pc = uint64_t(_dest);
-        if (std::binary_search(m_jumpDests.begin(), m_jumpDests.end(), pc))
+        if (std::binary_search(_jumpDests.begin(), _jumpDests.end(), pc))
             return pc;
     }
-    if (_throw)
-        throwBadJumpDestination();
     return -1;
 }
 
+int64_t VM::verifyJumpDest(u256 const& _dest, bool _throw)
+{
+    int64_t pc = findJumpDest(m_analysed->jumpDests, _dest);
+    if (pc < 0 && _throw)
+        throwBadJumpDestination();
+    return pc;
+}
+
 
 //
 // interpreter cases that call out
@@ -39,6 +39,8 @@ namespace eth
 //
 // EVM_REPLACE_CONST_JUMP - pre-verified jumps to save runtime lookup
 //
+// EVM_FIXED_WIDTH_ARITH  - arithmetic opcodes on 4x64-bit limbs instead of generic big ints
+//
 // EVM_TRACE              - provides various levels of tracing
 
 #ifndef EVM_JUMP_DISPATCH
@@ -65,6 +67,14 @@ namespace eth
 #define EVM_DO_FIRST_PASS_OPTIMIZATION (EVM_REPLACE_CONST_JUMP || EVM_USE_CONSTANT_POOL)
 #endif
 
+#ifndef EVM_FIXED_WIDTH_ARITH
+#if defined(__SIZEOF_INT128__) && (defined(__x86_64__) || defined(__aarch64__))
+#define EVM_FIXED_WIDTH_ARITH true
+#else
+#define EVM_FIXED_WIDTH_ARITH false
+#endif
+#endif
+
 
 ///////////////////////////////////////////////////////////////////////////////
 //
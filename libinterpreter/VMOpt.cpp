@@ -45,41 +45,73 @@ void VM::initMetrics()
     (void)done;
 }
 
-void VM::copyCode(int _extraBytes)
+void VM::copyCode(bytes& _code, uint8_t const* _src, size_t _size, int _extraBytes)
 {
     // Copy code so that it can be safely modified and extend code by
     // _extraBytes zero bytes to allow reading virtual data at the end
     // of the code without bounds checks.
-    auto extendedSize = m_codeSize + _extraBytes;
-    m_code.reserve(extendedSize);
-    m_code.assign(m_pCode, m_pCode + m_codeSize);
-    m_code.resize(extendedSize);
+    auto extendedSize = _size + _extraBytes;
+    _code.reserve(extendedSize);
+    _code.assign(_src, _src + _size);
+    _code.resize(extendedSize);
 }
 
 void VM::optimize()
 {
-    copyCode(33);
+    // the analysis depends on the code only, reuse it for code already run by any VM,
+    // init code of CREATE runs once, it's not worth caching
+    h256 codeHash(m_message->code_hash.bytes, h256::ConstructFromPointer);
+    bool cacheable = m_message->kind != EVMC_CREATE && m_message->kind != EVMC_CREATE2 &&
+                     codeHash != h256() && m_codeSize > 0;
+    auto& cache = AnalysedCodeCache::instance();
+    if (cacheable)
+    {
+        m_analysed = cache.get(codeHash);
+        // the size check guards against a caller passing a stale hash
+        if (m_analysed && m_analysed->code.size() != m_codeSize + c_extraCodeBytes)
+        {
+            m_analysed.reset();
+        }
+    }
+    if (!m_analysed)
+    {
+        m_analysed = analyse(m_pCode, m_codeSize);
+        if (cacheable)
+        {
+            cache.put(codeHash, m_analysed);
+        }
+    }
+
+    m_code = m_analysed->code.data();
+    m_pool = m_analysed->pool.data();
+}
+
+AnalysedCode::Ptr VM::analyse(uint8_t const* _code, size_t _size)
+{
+    auto analysed = std::make_shared<AnalysedCode>();
+    bytes& code = analysed->code;
+    copyCode(code, _code, _size, c_extraCodeBytes);
 
-    size_t const nBytes = m_codeSize;
+    size_t const nBytes = _size;
 
     // build a table of jump destinations for use in verifyJumpDest
 
     TRACE_STR(1, "Build JUMPDEST table")
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
         TRACE_OP(2, pc, op);
 
         // make synthetic ops in user code trigger invalid instruction if run
         if (op == Instruction::PUSHC || op == Instruction::JUMPC || op == Instruction::JUMPCI)
         {
             TRACE_OP(1, pc, op);
-            m_code[pc] = (byte)Instruction::INVALID;
+            code[pc] = (byte)Instruction::INVALID;
         }
 
         if (op == Instruction::JUMPDEST)
         {
-            m_jumpDests.push_back(pc);
+            analysed->jumpDests.push_back(pc);
         }
         else if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
         {
@@ -93,17 +125,17 @@ void VM::optimize()
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
         u256 val = 0;
-        Instruction op = Instruction(m_code[pc]);
+        Instruction op = Instruction(code[pc]);
 
         if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
         {
             byte nPush = (byte)op - (byte)Instruction::PUSH1 + 1;
 
             // decode pushed bytes to integral value
-            val = m_code[pc + 1];
+            val = code[pc + 1];
             for (uint64_t i = pc + 2, n = nPush; --n; ++i)
             {
-                val = (val << 8) | m_code[i];
+                val = (val << 8) | code[i];
             }
 
 #if EVM_USE_CONSTANT_POOL
@@ -113,16 +145,16 @@ void VM::optimize()
             // followed by one byte count of remaining pushed bytes
             if (5 < nPush)
             {
-                uint16_t pool_off = m_pool.size();
+                uint16_t pool_off = analysed->pool.size();
                 TRACE_VAL(1, "stash", val);
                 TRACE_VAL(1, "... in pool at offset", pool_off);
-                m_pool.push_back(val);
+                analysed->pool.push_back(val);
 
                 TRACE_PRE_OPT(1, pc, op);
-                m_code[pc] = byte(op = Instruction::PUSHC);
-                m_code[pc + 3] = nPush - 2;
-                m_code[pc + 2] = pool_off & 0xff;
-                m_code[pc + 1] = pool_off >> 8;
+                code[pc] = byte(op = Instruction::PUSHC);
+                code[pc + 3] = nPush - 2;
+                code[pc + 2] = pool_off & 0xff;
+                code[pc + 1] = pool_off >> 8;
                 TRACE_POST_OPT(1, pc, op);
             }
 
@@ -134,14 +166,14 @@ void VM::optimize()
             // outer loop is N = number of bytes in code array
             // so complexity is N log M, worst case is N log N
             size_t i = pc + nPush + 1;
-            op = Instruction(m_code[i]);
+            op = Instruction(code[i]);
             if (op == Instruction::JUMP)
             {
                 TRACE_VAL(1, "Replace const JUMP with JUMPC to", val)
                 TRACE_PRE_OPT(1, i, op);
 
-                if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPC);
+                if (0 <= findJumpDest(analysed->jumpDests, val))
+                    code[i] = byte(op = Instruction::JUMPC);
 
                 TRACE_POST_OPT(1, i, op);
             }
@@ -150,8 +182,8 @@ void VM::optimize()
                 TRACE_VAL(1, "Replace const JUMPI with JUMPCI to", val)
                 TRACE_PRE_OPT(1, i, op);
 
-                if (0 <= verifyJumpDest(val, false))
-                    m_code[i] = byte(op = Instruction::JUMPCI);
+                if (0 <= findJumpDest(analysed->jumpDests, val))
+                    code[i] = byte(op = Instruction::JUMPCI);
 
                 TRACE_POST_OPT(1, i, op);
             }
@@ -162,6 +194,7 @@ void VM::optimize()
     }
     TRACE_STR(1, "Finished optimizations")
 #endif
+    return analysed;
 }
 
 
@@ -175,25 +208,5 @@ void VM::initEntry()
     optimize();
 }
 
-
-// Implementation of EXP.
-//
-// This implements exponentiation by squaring algorithm.
-// Is faster than boost::multiprecision::powm() because it avoids explicit
-// mod operation.
-// Do not inline it.
-u256 VM::exp256(u256 _base, u256 _exponent)
-{
-    using boost::multiprecision::limb_type;
-    u256 result = 1;
-    while (_exponent)
-    {
-        if (static_cast<limb_type>(_exponent) & 1)  // If exponent is odd.
-            result *= _base;
-        _base *= _base;
-        _exponent >>= 1;
-    }
-    return result;
-}
 }  // namespace eth
 }  // namespace dev
@@ -26,6 +26,8 @@
 #include <libdevcore/Common.h>
 #include <libmptstate/MPTStateFactory.h>
 #include <libsecurity/EncryptedLevelDB.h>
+#include <libstorage/AsyncCommitStorage.h>
+#include <libstorage/CachedStorage.h>
 #include <libstorage/LevelDBStorage.h>
 #include <libstoragestate/StorageStateFactory.h>
 
@@ -100,7 +102,23 @@ void DBInitializer::initLevelDBStorage()
         std::shared_ptr<dev::db::BasicLevelDB> leveldb_handler =
             std::shared_ptr<dev::db::BasicLevelDB>(pleveldb);
         leveldb_storage->setDB(leveldb_handler);
+        // the calling thread reads a part of the batch selects too
+        leveldb_storage->setReadThreads(m_param->mutableStorageParam().readThreads);
         m_storage = leveldb_storage;
+
+        if (m_param->mutableStorageParam().asyncCommit)
+        {
+            DBInitializer_LOG(DEBUG) << "[#initStorageDB] [#initLevelDBStorage] asyncCommit";
+            m_storage = std::make_shared<AsyncCommitStorage>(m_storage);
+        }
+
+        uint64_t cacheSize = m_param->mutableStorageParam().cacheSize;
+        if (cacheSize > 0)
+        {
+            DBInitializer_LOG(DEBUG)
+                << "[#initStorageDB] [#initLevelDBStorage] [cacheSizeMB]: " << cacheSize;
+            m_storage = std::make_shared<CachedStorage>(m_storage, cacheSize * 1024 * 1024);
+        }
     }
     catch (std::exception& e)
     {
@@ -131,6 +149,7 @@ void DBInitializer::createExecutiveContext()
     m_executiveContextFac->setStateStorage(m_storage);
     // mpt or storage
     m_executiveContextFac->setStateFactory(m_stateFactory);
+    m_executiveContextFac->setExactConditions(m_param->mutableStorageParam().exactConditions);
     DBInitializer_LOG(DEBUG) << "[#createExecutiveContext SUCC]" << std::endl;
 }
 
@@ -157,7 +176,9 @@ void DBInitializer::createStateFactory(dev::h256 const& genesisHash)
 void DBInitializer::createStorageState()
 {
     DBInitializer_LOG(DEBUG) << "[#createStateFactory] [#createStorageState]" << std::endl;
-    m_stateFactory = std::make_shared<StorageStateFactory>(u256(0x0));
+    auto stateFactory = std::make_shared<StorageStateFactory>(u256(0x0));
+    stateFactory->setBinaryStorage(m_param->mutableStateParam().binaryStorage);
+    m_stateFactory = stateFactory;
     DBInitializer_LOG(DEBUG) << "[#createStateFactory] [#createStorageState SUCC]" << std::endl;
 }
 
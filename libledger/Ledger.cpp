@@ -111,15 +111,23 @@ void Ledger::initIniConfig(std::string const& iniConfigFileName)
 {
     try
     {
-        Ledger_LOG(INFO) << "[#initIniConfig] [initTxPoolConfig/initSyncConfig] fileName:"
-                         << iniConfigFileName;
+        Ledger_LOG(INFO)
+            << "[#initIniConfig] [initTxPoolConfig/initConsensusIniConfig/initSyncConfig/"
+               "initStorageConfig/initTxExecuteConfig] fileName:"
+            << iniConfigFileName;
         ptree pt;
         /// read the configuration file for a specified group
         read_ini(iniConfigFileName, pt);
         /// init params related to txpool
         initTxPoolConfig(pt);
+        /// init params related to the consensus of this node
+        initConsensusIniConfig(pt);
         /// init params related to sync
         initSyncConfig(pt);
+        /// init params related to the storage cache
+        initStorageConfig(pt);
+        /// init params related to the transaction execution
+        initTxExecuteConfig(pt);
     }
     catch (std::exception& e)
     {
@@ -151,16 +159,19 @@ void Ledger::initConsensusConfig(ptree const& pt)
     m_param->mutableConsensusParam().maxTransactions =
         pt.get<uint64_t>("consensus.maxTransNum", 1000);
     m_param->mutableConsensusParam().maxTTL = pt.get<uint8_t>("consensus.maxTTL", MAXTTL);
+    m_param->mutableConsensusParam().compactPrepare =
+        pt.get<bool>("consensus.compactPrepare", false);
 
     m_param->mutableConsensusParam().minElectTime =
         pt.get<uint64_t>("consensus.minElectTime", 1000);
     m_param->mutableConsensusParam().maxElectTime =
         pt.get<uint64_t>("consensus.maxElectTime", 2000);
 
-    Ledger_LOG(DEBUG) << "[#initConsensusConfig] [type/maxTxNum/maxTTL]:  "
+    Ledger_LOG(DEBUG) << "[#initConsensusConfig] [type/maxTxNum/maxTTL/compactPrepare]:  "
                       << m_param->mutableConsensusParam().consensusType << "/"
                       << m_param->mutableConsensusParam().maxTransactions << "/"
-                      << std::to_string(m_param->mutableConsensusParam().maxTTL);
+                      << std::to_string(m_param->mutableConsensusParam().maxTTL) << "/"
+                      << m_param->mutableConsensusParam().compactPrepare;
 
     std::string nodeListMark;
     try
@@ -188,19 +199,68 @@ void Ledger::initConsensusConfig(ptree const& pt)
     m_param->mutableGenesisParam().nodeListMark = nodeListMark;
 }
 
+/// init consensus related configurations of this node
+/// 1. verifyThreads: threads of each pbft signature verify pool, default is one per CPU core,
+///    nodes running several groups should split the cores between them
+void Ledger::initConsensusIniConfig(ptree const& pt)
+{
+    m_param->mutableConsensusParam().verifyThreads =
+        pt.get<unsigned>("consensus.verifyThreads", defaultPoolThreads());
+    Ledger_LOG(DEBUG) << "[#initConsensusIniConfig] [verifyThreads]:"
+                      << m_param->mutableConsensusParam().verifyThreads << std::endl;
+}
+
 /// init sync related configurations
 /// 1. idleWaitMs: default is 30ms
+/// 2. verifyThreads: threads decoding the downloaded blocks, default is one per CPU core,
+///    0 decodes them on the sync thread
 void Ledger::initSyncConfig(ptree const& pt)
 {
     m_param->mutableSyncParam().idleWaitMs =
         pt.get<unsigned>("sync.idleWaitMs", SYNC_IDLE_WAIT_DEFAULT);
-    Ledger_LOG(DEBUG) << "[#initSyncConfig] [idleWaitMs]:" << m_param->mutableSyncParam().idleWaitMs
-                      << std::endl;
+    m_param->mutableSyncParam().verifyThreads =
+        pt.get<unsigned>("sync.verifyThreads", defaultPoolThreads());
+    Ledger_LOG(DEBUG) << "[#initSyncConfig] [idleWaitMs/verifyThreads]:"
+                      << m_param->mutableSyncParam().idleWaitMs << "/"
+                      << m_param->mutableSyncParam().verifyThreads << std::endl;
+}
+
+/// init storage related configurations of this node
+/// 1. cacheSize: MB of the storage read cache, default is 256MB, 0 disables the cache
+/// 2. asyncCommit: persist committed blocks in the background, default is true
+/// 3. readThreads: threads reading batch selects besides the calling one, default is one per
+///    CPU core minus the calling one
+void Ledger::initStorageConfig(ptree const& pt)
+{
+    m_param->mutableStorageParam().cacheSize =
+        pt.get<uint64_t>("storage.cacheSize", STORAGE_CACHE_SIZE_DEFAULT);
+    m_param->mutableStorageParam().asyncCommit = pt.get<bool>("storage.asyncCommit", true);
+    m_param->mutableStorageParam().readThreads =
+        pt.get<unsigned>("storage.readThreads", defaultPoolThreads() - 1);
+    Ledger_LOG(DEBUG) << "[#initStorageConfig] [cacheSize/asyncCommit/readThreads]:"
+                      << m_param->mutableStorageParam().cacheSize << "/"
+                      << m_param->mutableStorageParam().asyncCommit << "/"
+                      << m_param->mutableStorageParam().readThreads << std::endl;
+}
+
+/// init transaction execution related configurations of this node
+/// 1. enableParallel: execute the transactions of a block on multiple threads, default is false
+/// 2. parallelThreads: threads of the parallel execution, default is one per CPU core
+void Ledger::initTxExecuteConfig(ptree const& pt)
+{
+    m_param->mutableTxParam().enableParallel = pt.get<bool>("tx.enableParallel", false);
+    m_param->mutableTxParam().parallelThreads =
+        pt.get<unsigned>("tx.parallelThreads", defaultPoolThreads());
+    Ledger_LOG(DEBUG) << "[#initTxExecuteConfig] [enableParallel/parallelThreads]:"
+                      << m_param->mutableTxParam().enableParallel << "/"
+                      << m_param->mutableTxParam().parallelThreads << std::endl;
 }
 
 /// init db related configurations:
 /// dbType: leveldb/AMDB, storage type, default is "AMDB"
 /// mpt: true/false, enable mpt or not, default is true
+/// intermediateRoot: commit the mpt state per transaction, default is true
+/// binaryStorage: storage state keeps the contract storage slots in binary, default is false
 /// dbpath: data to place all data of the group, default is "data"
 void Ledger::initDBConfig(ptree const& pt)
 {
@@ -208,12 +268,20 @@ void Ledger::initDBConfig(ptree const& pt)
     /// set storage db related param
     m_param->mutableStorageParam().type = pt.get<std::string>("storage.type", "LevelDB");
     m_param->mutableStorageParam().path = m_param->baseDir() + "/block";
+    m_param->mutableStorageParam().exactConditions =
+        pt.get<bool>("storage.exactConditions", false);
     /// set state db related param
     m_param->mutableStateParam().type = pt.get<std::string>("state.type", "mpt");
+    m_param->mutableStateParam().intermediateRoot = pt.get<bool>("state.intermediateRoot", true);
+    m_param->mutableStateParam().binaryStorage = pt.get<bool>("state.binaryStorage", false);
 
     Ledger_LOG(DEBUG) << "[#initDBConfig] [storageDB/storagePath/stateDB/baseDir]:  "
                       << m_param->mutableStorageParam().type << "/"
                       << m_param->mutableStorageParam().path << "/" << m_param->baseDir()
+                      << " [exactConditions]: " << m_param->mutableStorageParam().exactConditions
+                      << " [intermediateRoot/binaryStorage]: "
+                      << m_param->mutableStateParam().intermediateRoot << "/"
+                      << m_param->mutableStateParam().binaryStorage
                       << std::endl;
 }
 
@@ -236,11 +304,41 @@ void Ledger::initMark()
     s << m_param->mutableStateParam().type << "-";
     s << m_param->mutableConsensusParam().maxTransactions << "-";
     s << m_param->mutableTxParam().txGasLimit;
+    /// options which change the block hashes, they are marked only when they differ from the
+    /// default so that the marks of existing chains stay the same, see resetMarkOptions
+    if (!m_param->mutableStateParam().intermediateRoot)
+        s << "-intermediateRoot:false";
+    if (m_param->mutableStateParam().binaryStorage)
+        s << "-binaryStorage:true";
+    if (m_param->mutableStorageParam().exactConditions)
+        s << "-exactConditions:true";
     m_param->mutableGenesisParam().genesisMark = s.str();
     Ledger_LOG(DEBUG) << "[#initMark] [genesisMark]:  "
                       << m_param->mutableGenesisParam().genesisMark << std::endl;
 }
 
+void Ledger::resetMarkOptions(std::vector<std::string> const& _options)
+{
+    m_param->mutableStateParam().intermediateRoot = true;
+    m_param->mutableStateParam().binaryStorage = false;
+    m_param->mutableStorageParam().exactConditions = false;
+    for (auto const& option : _options)
+    {
+        if (option == "intermediateRoot:false")
+            m_param->mutableStateParam().intermediateRoot = false;
+        else if (option == "binaryStorage:true")
+            m_param->mutableStateParam().binaryStorage = true;
+        else if (option == "exactConditions:true")
+            m_param->mutableStorageParam().exactConditions = true;
+        else
+            Ledger_LOG(WARNING) << "[#resetMarkOptions] unknown option:" << option;
+    }
+    Ledger_LOG(DEBUG) << "[#resetMarkOptions] [intermediateRoot/binaryStorage/exactConditions]:"
+                      << m_param->mutableStateParam().intermediateRoot << "/"
+                      << m_param->mutableStateParam().binaryStorage << "/"
+                      << m_param->mutableStorageParam().exactConditions;
+}
+
 /// init txpool
 bool Ledger::initTxPool()
 {
@@ -274,6 +372,21 @@ bool Ledger::initBlockVerifier()
     std::shared_ptr<BlockChainImp> blockChain =
         std::dynamic_pointer_cast<BlockChainImp>(m_blockChain);
     blockVerifier->setNumberHash(boost::bind(&BlockChainImp::numberHash, blockChain, _1));
+    blockVerifier->setIntermediateRoot(m_param->mutableStateParam().intermediateRoot);
+    if (m_param->mutableTxParam().enableParallel)
+    {
+        /// the conflict detection relies on the MemoryTableFactory which backs the storage state
+        if (dev::stringCmpIgnoreCase(m_param->mutableStateParam().type, "storage") == 0)
+        {
+            blockVerifier->setParallelThreads(m_param->mutableTxParam().parallelThreads);
+        }
+        else
+        {
+            Ledger_LOG(WARNING) << "[#initLedger] [#initBlockVerifier] parallel execution is "
+                                   "only supported by the storage state, disabled"
+                                << std::endl;
+        }
+    }
     m_blockVerifier = blockVerifier;
     Ledger_LOG(DEBUG) << "[#initLedger] [#initBlockVerifier SUCC]" << std::endl;
     return true;
@@ -307,6 +420,7 @@ bool Ledger::initBlockChain()
         m_param->mutableConsensusParam().consensusType = initParam.consensusType;
         m_param->mutableStorageParam().type = initParam.storageType;
         m_param->mutableStateParam().type = initParam.stateType;
+        resetMarkOptions(initParam.markOptions);
     }
     Ledger_LOG(DEBUG) << "[#initLedger] [#initBlockChain SUCC]";
     return true;
@@ -342,6 +456,8 @@ std::shared_ptr<Sealer> Ledger::createPBFTSealer()
     pbftEngine->setStorage(m_dbInitializer->storage());
     pbftEngine->setOmitEmptyBlock(SystemConfigMgr::c_omitEmptyBlock);
     pbftEngine->setMaxTTL(m_param->mutableConsensusParam().maxTTL);
+    pbftEngine->setCompactPrepare(m_param->mutableConsensusParam().compactPrepare);
+    pbftEngine->setVerifyThreads(m_param->mutableConsensusParam().verifyThreads);
     return pbftSealer;
 }
 
@@ -420,7 +536,8 @@ bool Ledger::initSync()
     dev::PROTOCOL_ID protocol_id = getGroupProtoclID(m_groupId, ProtocolID::BlockSync);
     dev::h256 genesisHash = m_blockChain->getBlockByNumber(int64_t(0))->headerHash();
     m_sync = std::make_shared<SyncMaster>(m_service, m_txPool, m_blockChain, m_blockVerifier,
-        protocol_id, m_keyPair.pub(), genesisHash, m_param->mutableSyncParam().idleWaitMs);
+        protocol_id, m_keyPair.pub(), genesisHash, m_param->mutableSyncParam().idleWaitMs,
+        m_param->mutableSyncParam().verifyThreads);
     Ledger_LOG(DEBUG) << "[#initLedger] [#initSync SUCC]" << std::endl;
     return true;
 }
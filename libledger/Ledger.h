@@ -150,10 +150,17 @@ private:
     void initCommonConfig(boost::property_tree::ptree const& pt);
     void initTxPoolConfig(boost::property_tree::ptree const& pt);
     void initConsensusConfig(boost::property_tree::ptree const& pt);
+    /// init the consensus configurations of this node, which aren't part of the genesis
+    void initConsensusIniConfig(boost::property_tree::ptree const& pt);
     void initSyncConfig(boost::property_tree::ptree const& pt);
+    void initStorageConfig(boost::property_tree::ptree const& pt);
+    /// init the transaction execution related configurations
+    void initTxExecuteConfig(boost::property_tree::ptree const& pt);
     void initDBConfig(boost::property_tree::ptree const& pt);
     void initTxConfig(boost::property_tree::ptree const& pt);
     void initMark();
+    /// reset the options of the mark to the ones of an existing genesis block
+    void resetMarkOptions(std::vector<std::string> const& _options);
     /// load ini config of group
     void initIniConfig(std::string const& iniConfigFileName);
 
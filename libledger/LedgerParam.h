@@ -24,7 +24,9 @@
 #pragma once
 #include "LedgerParamInterface.h"
 #include <libdevcore/FixedHash.h>
+#include <algorithm>
 #include <memory>
+#include <thread>
 #include <vector>
 
 namespace dev
@@ -33,6 +35,11 @@ namespace ledger
 {
 /// forward class declaration
 #define SYNC_TX_POOL_SIZE_DEFAULT 102400
+/// the default size of the worker pools of a group, one thread per CPU core
+inline unsigned defaultPoolThreads()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
 struct TxPoolParam
 {
     uint64_t txPoolLimit = SYNC_TX_POOL_SIZE_DEFAULT;
@@ -44,9 +51,13 @@ struct ConsensusParam
     dev::h512s observerList = dev::h512s();
     uint64_t maxTransactions;
     uint8_t maxTTL;
+    /// broadcast the header and the transaction hashes instead of the block
+    bool compactPrepare = false;
     /// unsigned intervalBlockTime;
     uint64_t minElectTime;
     uint64_t maxElectTime;
+    /// threads of each pbft signature verify pool of this node
+    unsigned verifyThreads = defaultPoolThreads();
 };
 
 struct AMDBParam
@@ -61,6 +72,8 @@ struct SyncParam
 {
     /// TODO: syncParam related
     unsigned idleWaitMs = SYNC_IDLE_WAIT_DEFAULT;
+    /// threads decoding the downloaded blocks, 0 decodes them on the sync thread
+    unsigned verifyThreads = defaultPoolThreads();
 };
 
 struct GenesisParam
@@ -68,18 +81,38 @@ struct GenesisParam
     std::string genesisMark;
     std::string nodeListMark;
 };
+/// 256MB
+#define STORAGE_CACHE_SIZE_DEFAULT 256
 struct StorageParam
 {
     std::string type;
     std::string path;
+    /// MB of memory for the cross-block read cache, 0 disables it
+    uint64_t cacheSize = STORAGE_CACHE_SIZE_DEFAULT;
+    /// write committed blocks to disk in the background
+    bool asyncCommit = true;
+    /// table conditions compare numbers of any size and select applies the limit
+    bool exactConditions = false;
+    /// threads reading the keys of batch selects besides the calling one, 0 reads them on the
+    /// calling thread
+    unsigned readThreads = defaultPoolThreads() - 1;
 };
 struct StateParam
 {
     std::string type;
+    /// commit the mpt state after every transaction, so that receipts carry the intermediate
+    /// state root, otherwise the trie is committed once per block
+    bool intermediateRoot = true;
+    /// storage state only: keep the storage slots of contracts in binary instead of decimal
+    bool binaryStorage = false;
 };
 struct TxParam
 {
     uint64_t txGasLimit;
+    /// execute the transactions of a block on multiple threads
+    bool enableParallel = false;
+    /// threads executing the transactions of a block when enableParallel is set
+    unsigned parallelThreads = defaultPoolThreads();
 };
 class LedgerParam : public LedgerParamInterface
 {
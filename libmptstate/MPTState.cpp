@@ -150,6 +150,11 @@ void MPTState::commit()
     m_state.commit();
 }
 
+void MPTState::commitTransaction()
+{
+    m_state.commitTransaction();
+}
+
 void MPTState::dbCommit(h256 const&, int64_t)
 {
     m_state.db().commit();
@@ -50,6 +50,7 @@ State::State(State const& _s)
     m_cache(_s.m_cache),
     m_unchangedCacheEntries(_s.m_unchangedCacheEntries),
     m_nonExistingAccountsCache(_s.m_nonExistingAccountsCache),
+    m_blockCache(_s.m_blockCache),
     m_touched(_s.m_touched),
     m_accountStartNonce(_s.m_accountStartNonce),
     m_changeLog(_s.m_changeLog)
@@ -133,6 +134,7 @@ State& State::operator=(State const& _s)
     m_cache = _s.m_cache;
     m_unchangedCacheEntries = _s.m_unchangedCacheEntries;
     m_nonExistingAccountsCache = _s.m_nonExistingAccountsCache;
+    m_blockCache = _s.m_blockCache;
     m_touched = _s.m_touched;
     m_accountStartNonce = _s.m_accountStartNonce;
     return *this;
@@ -149,6 +151,19 @@ Account* State::account(Address const& _addr)
     if (it != m_cache.end())
         return &it->second;
 
+    // changed by a previous transaction of the block, copied so that a rollback of this
+    // transaction, which may erase the entry of m_cache, falls back to it
+    auto blockIt = m_blockCache.find(_addr);
+    if (blockIt != m_blockCache.end())
+    {
+        if (!blockIt->second.isAlive())
+            return nullptr;
+        clearCacheIfTooLarge();
+        auto i = m_cache.insert(*blockIt);
+        m_unchangedCacheEntries.push_back(_addr);
+        return &i.first->second;
+    }
+
     if (m_nonExistingAccountsCache.count(_addr))
         return nullptr;
 
@@ -197,11 +212,26 @@ void State::clearCacheIfTooLarge() const
 }
 
 void State::commit()
+{
+    commitTransaction();
+    m_touched += dev::mptstate::commit(m_blockCache, m_state);
+    m_blockCache.clear();
+}
+
+void State::commitTransaction()
 {
     // Remove empty accounts by default
     removeEmptyAccounts();
-    m_touched += dev::mptstate::commit(m_cache, m_state);
     m_changeLog.clear();
+    for (auto& i : m_cache)
+    {
+        // an unchanged copy is older than or equal to the block entry
+        auto blockIt = m_blockCache.find(i.first);
+        if (blockIt == m_blockCache.end())
+            m_blockCache.emplace(i.first, std::move(i.second));
+        else if (i.second.isDirty())
+            blockIt->second = std::move(i.second);
+    }
     m_cache.clear();
     m_unchangedCacheEntries.clear();
 }
@@ -281,6 +311,7 @@ std::pair<State::AddressMap, h256> State::addresses(
 void State::setRoot(h256 const& _r)
 {
     m_cache.clear();
+    m_blockCache.clear();
     m_unchangedCacheEntries.clear();
     m_nonExistingAccountsCache.clear();
     //  m_touched.clear();
@@ -311,6 +311,11 @@ public:
     /// Commit all changes waiting in the address cache to the DB. Remove empty account
     void commit();
 
+    /// Finish a transaction without touching the trie: remove empty accounts and keep the
+    /// changed and loaded accounts for the next transactions of the block. rootHash() is
+    /// not updated until the next commit(), which hashes the whole block at once.
+    void commitTransaction();
+
     /// Resets any uncommitted changes to the cache.
     void setRoot(h256 const& _root);
 
@@ -328,7 +333,11 @@ public:
 
     ChangeLog const& changeLog() const { return m_changeLog; }
 
-    void cacheClear() { return m_cache.clear(); }
+    void cacheClear()
+    {
+        m_cache.clear();
+        m_blockCache.clear();
+    }
 
 private:
     /// Turns all "touched" empty accounts into non-alive accounts.
@@ -357,6 +366,8 @@ private:
                                                            ///< too large.
     mutable std::set<Address> m_nonExistingAccountsCache;  ///< Tracks addresses that are known to
                                                            ///< not exist.
+    AccountMap m_blockCache;  ///< Accounts of the previous transactions since the last commit(),
+                              ///< dead ones stand for accounts removed from the trie.
     AddressHash m_touched;                                 ///< Tracks all addresses touched so far.
 
     u256 m_accountStartNonce;
@@ -79,7 +79,7 @@ std::string Rpc::getBlockNumber(int _groupID)
             BOOST_THROW_EXCEPTION(
                 JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
 
-        return toJS(blockchain->number());
+        return toJS(blockchain->durableNumber());
     }
     catch (JsonRpcException& e)
     {
@@ -386,7 +386,8 @@ Json::Value Rpc::getBlockByHash(
 
         h256 hash = jsToFixed<32>(_blockHash);
         auto block = blockchain->getBlockByHash(hash);
-        if (!block)
+        /// the block is reported once it has been persisted
+        if (!block || block->header().number() > blockchain->durableNumber())
             BOOST_THROW_EXCEPTION(
                 JsonRpcException(RPCExceptionType::BlockHash, RPCMsg[RPCExceptionType::BlockHash]));
 
@@ -446,6 +447,10 @@ Json::Value Rpc::getBlockByNumber(
             BOOST_THROW_EXCEPTION(
                 JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
 
+        /// the block is reported once it has been persisted
+        if (number > blockchain->durableNumber())
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
         auto block = blockchain->getBlockByNumber(number);
         if (!block)
             BOOST_THROW_EXCEPTION(JsonRpcException(
@@ -533,6 +538,9 @@ Json::Value Rpc::getTransactionByHash(int _groupID, const std::string& _transact
         auto tx = blockchain->getLocalisedTxByHash(hash);
         if (tx.blockNumber() == INVALIDNUMBER)
             return Json::nullValue;
+        /// the transaction is reported once its block has been persisted
+        if (tx.blockNumber() > blockchain->durableNumber())
+            return Json::nullValue;
 
         response["blockHash"] = toJS(tx.blockHash());
         response["blockNumber"] = toJS(tx.blockNumber());
@@ -578,7 +586,7 @@ Json::Value Rpc::getTransactionByBlockHashAndIndex(
 
         h256 hash = jsToFixed<32>(_blockHash);
         auto block = blockchain->getBlockByHash(hash);
-        if (!block)
+        if (!block || block->header().number() > blockchain->durableNumber())
             BOOST_THROW_EXCEPTION(
                 JsonRpcException(RPCExceptionType::BlockHash, RPCMsg[RPCExceptionType::BlockHash]));
 
@@ -632,6 +640,9 @@ Json::Value Rpc::getTransactionByBlockNumberAndIndex(
                 JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
 
         BlockNumber number = jsToBlockNumber(_blockNumber);
+        if (number > blockchain->durableNumber())
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
         auto block = blockchain->getBlockByNumber(number);
         if (!block)
             BOOST_THROW_EXCEPTION(JsonRpcException(
@@ -688,6 +699,9 @@ Json::Value Rpc::getTransactionReceipt(int _groupID, const std::string& _transac
         auto txReceipt = blockchain->getLocalisedTxReceiptByHash(hash);
         if (txReceipt.blockNumber() == INVALIDNUMBER)
             return Json::nullValue;
+        /// the receipt is reported once its block has been persisted
+        if (txReceipt.blockNumber() > blockchain->durableNumber())
+            return Json::nullValue;
 
         response["transactionHash"] = _transactionHash;
         response["transactionIndex"] = toJS(txReceipt.transactionIndex());
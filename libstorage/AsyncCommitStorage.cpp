@@ -0,0 +1,226 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file AsyncCommitStorage.cpp
+ *  @author agent
+ *  @date 20261018
+ */
+
+#include "AsyncCommitStorage.h"
+#include "Common.h"
+#include <libdevcore/easylog.h>
+
+using namespace dev;
+using namespace dev::storage;
+
+AsyncCommitStorage::AsyncCommitStorage(Storage::Ptr _backend, size_t _maxPending)
+  : m_backend(_backend), m_maxPending(_maxPending > 0 ? _maxPending : 1)
+{
+    m_writer.reset(new dev::ThreadPool("StorageCommit", 1));
+}
+
+AsyncCommitStorage::~AsyncCommitStorage()
+{
+    try
+    {
+        flush();
+    }
+    catch (std::exception& e)
+    {
+        STORAGE_LOG(ERROR) << "[#AsyncCommitStorage] flush failed: "
+                           << boost::diagnostic_information(e);
+    }
+    m_writer->stop();
+}
+
+Entries::Ptr AsyncCommitStorage::select(
+    h256 hash, int num, const std::string& table, const std::string& key)
+{
+    {
+        Guard l(m_lock);
+        auto it = m_staged.find(stageKey(table, key));
+        if (it != m_staged.end())
+        {
+            return copyEntries(it->second.entries);
+        }
+    }
+    return m_backend->select(hash, num, table, key);
+}
+
+std::vector<Entries::Ptr> AsyncCommitStorage::batchSelect(
+    h256 hash, int num, std::vector<TableKey> const& keys)
+{
+    std::vector<Entries::Ptr> result(keys.size());
+    std::vector<size_t> unstaged;
+    std::vector<TableKey> unstagedKeys;
+    {
+        Guard l(m_lock);
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            auto it = m_staged.find(stageKey(keys[i].table, keys[i].key));
+            if (it != m_staged.end())
+            {
+                result[i] = copyEntries(it->second.entries);
+            }
+            else
+            {
+                unstaged.push_back(i);
+                unstagedKeys.push_back(keys[i]);
+            }
+        }
+    }
+    if (!unstaged.empty())
+    {
+        auto entries = m_backend->batchSelect(hash, num, unstagedKeys);
+        for (size_t j = 0; j < unstaged.size(); ++j)
+        {
+            result[unstaged[j]] = entries[j];
+        }
+    }
+    return result;
+}
+
+size_t AsyncCommitStorage::commit(
+    h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash)
+{
+    Job job{hash, num, datas, blockHash, std::vector<std::string>()};
+    std::vector<std::pair<std::string, Entries::Ptr>> staged;
+    for (auto const& tableData : datas)
+    {
+        for (auto const& dataIt : tableData->data)
+        {
+            // empty lists are not written by the backend
+            if (dataIt.second->size() == 0u)
+            {
+                continue;
+            }
+            staged.emplace_back(stageKey(tableData->tableName, dataIt.first),
+                committedEntries(dataIt.second, hash, num));
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> l(m_lock);
+        m_signal.wait(l, [&]() { return m_jobs.size() < m_maxPending || m_error; });
+        checkError();
+
+        for (auto& it : staged)
+        {
+            m_staged[it.first] = StagedEntries{it.second, num};
+            job.keys.push_back(it.first);
+        }
+        m_jobs.push_back(std::move(job));
+    }
+    m_writer->enqueue([this]() { writeFront(); });
+
+    STORAGE_LOG(DEBUG) << "[#AsyncCommitStorage] staged [num/keys]: " << num << "/"
+                       << staged.size();
+    return staged.size();
+}
+
+bool AsyncCommitStorage::onlyDirty()
+{
+    return m_backend->onlyDirty();
+}
+
+int64_t AsyncCommitStorage::pendingNumber()
+{
+    Guard l(m_lock);
+    if (m_jobs.empty())
+    {
+        return m_backend->pendingNumber();
+    }
+    return m_jobs.front().num;
+}
+
+void AsyncCommitStorage::setPersistHandler(std::function<void(int64_t)> _handler)
+{
+    Guard l(m_lock);
+    m_persistHandler = _handler;
+}
+
+void AsyncCommitStorage::flush()
+{
+    std::unique_lock<std::mutex> l(m_lock);
+    m_signal.wait(l, [&]() { return m_jobs.empty() || m_error; });
+    checkError();
+}
+
+void AsyncCommitStorage::writeFront()
+{
+    Job* job = nullptr;
+    {
+        Guard l(m_lock);
+        if (m_error || m_jobs.empty())
+        {
+            return;
+        }
+        /// only this thread pops, the front job stays valid until then
+        job = &m_jobs.front();
+    }
+
+    try
+    {
+        m_backend->commit(job->hash, job->num, job->datas, job->blockHash);
+    }
+    catch (std::exception& e)
+    {
+        STORAGE_LOG(ERROR) << "[#AsyncCommitStorage] commit failed [num]: " << job->num << " "
+                           << boost::diagnostic_information(e);
+        Guard l(m_lock);
+        m_error = std::current_exception();
+        m_signal.notify_all();
+        return;
+    }
+
+    int64_t num = job->num;
+    std::function<void(int64_t)> persistHandler;
+    {
+        Guard l(m_lock);
+        for (auto const& key : job->keys)
+        {
+            auto it = m_staged.find(key);
+            if (it != m_staged.end() && it->second.num == job->num)
+            {
+                m_staged.erase(it);
+            }
+        }
+        m_jobs.pop_front();
+        persistHandler = m_persistHandler;
+    }
+    if (persistHandler)
+    {
+        persistHandler(num);
+    }
+    m_signal.notify_all();
+}
+
+void AsyncCommitStorage::checkError()
+{
+    if (m_error)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+std::string AsyncCommitStorage::stageKey(const std::string& table, const std::string& key)
+{
+    std::string stageKey;
+    stageKey.reserve(table.size() + key.size() + 1);
+    stageKey.append(table).push_back('\0');
+    stageKey.append(key);
+    return stageKey;
+}
@@ -0,0 +1,105 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file AsyncCommitStorage.h
+ *  @author agent
+ *  @date 20261018
+ */
+#pragma once
+
+#include "Storage.h"
+#include <libdevcore/Guards.h>
+#include <libdevcore/ThreadPool.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <unordered_map>
+
+namespace dev
+{
+namespace storage
+{
+/**
+ * Storage decorator which writes committed blocks to the backend on a
+ * background thread, so the next block can execute while the previous one
+ * is being persisted.
+ *
+ * commit() stages the rows in memory and returns, select() serves staged
+ * rows before the backend, so readers always see the latest committed
+ * block. At most maxPending blocks are in flight; commit() waits for the
+ * oldest one otherwise. Blocks reach the backend in order, each one in a
+ * single backend commit, so after a crash the backend holds a prefix of
+ * the chain and the missing blocks are synchronized again.
+ */
+class AsyncCommitStorage : public Storage
+{
+public:
+    typedef std::shared_ptr<AsyncCommitStorage> Ptr;
+
+    AsyncCommitStorage(Storage::Ptr _backend, size_t _maxPending = 1);
+    virtual ~AsyncCommitStorage();
+
+    virtual Entries::Ptr select(
+        h256 hash, int num, const std::string& table, const std::string& key) override;
+    virtual std::vector<Entries::Ptr> batchSelect(
+        h256 hash, int num, std::vector<TableKey> const& keys) override;
+    virtual size_t commit(
+        h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash) override;
+    virtual bool onlyDirty() override;
+    virtual int64_t pendingNumber() override;
+    /// called on the writer thread, after pendingNumber() moved past the block and before flush()
+    /// returns
+    virtual void setPersistHandler(std::function<void(int64_t)> _handler) override;
+
+    /// block until every staged block reached the backend
+    /// throws the backend error if a background commit failed
+    void flush();
+
+private:
+    struct StagedEntries
+    {
+        Entries::Ptr entries;
+        int64_t num;
+    };
+    struct Job
+    {
+        h256 hash;
+        int64_t num;
+        std::vector<TableData::Ptr> datas;
+        h256 blockHash;
+        std::vector<std::string> keys;
+    };
+
+    void writeFront();
+    void checkError();
+    static std::string stageKey(const std::string& table, const std::string& key);
+
+    Storage::Ptr m_backend;
+    size_t m_maxPending;
+
+    mutable Mutex m_lock;
+    std::condition_variable m_signal;
+    std::deque<Job> m_jobs;
+    std::unordered_map<std::string, StagedEntries> m_staged;
+    std::exception_ptr m_error;
+    std::function<void(int64_t)> m_persistHandler;
+
+    std::unique_ptr<dev::ThreadPool> m_writer;
+};
+
+}  // namespace storage
+
+}  // namespace dev
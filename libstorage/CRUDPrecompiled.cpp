@@ -75,7 +75,7 @@ bytes CRUDPrecompiled::call(
             auto entries = table->select(key, table->newCondition());
             auto entriesPrecompiled = std::make_shared<EntriesPrecompiled>();
             entriesPrecompiled->setEntries(entries);
-            auto newAddress = context->registerPrecompiled(entriesPrecompiled);
+            auto newAddress = context->registerTransientPrecompiled(entriesPrecompiled);
             out = abi.abiIn("", newAddress);
         }
     }
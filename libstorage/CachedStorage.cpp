@@ -0,0 +1,257 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file CachedStorage.cpp
+ *  @author agent
+ *  @date 20261018
+ */
+
+#include "CachedStorage.h"
+#include "Common.h"
+#include <libdevcore/easylog.h>
+
+using namespace dev;
+using namespace dev::storage;
+
+CachedStorage::CachedStorage(Storage::Ptr _backend, size_t _capacity, size_t _shardCount)
+  : m_backend(_backend)
+{
+    if (_shardCount == 0)
+    {
+        _shardCount = 1;
+    }
+    m_shardCapacity = _capacity / _shardCount;
+    for (size_t i = 0; i < _shardCount; ++i)
+    {
+        m_shards.emplace_back(new Shard(m_shardCapacity));
+    }
+}
+
+Entries::Ptr CachedStorage::select(
+    h256 hash, int num, const std::string& table, const std::string& key)
+{
+    auto cacheKey = CachedStorage::cacheKey(table, key);
+    auto& cacheShard = shard(cacheKey);
+    {
+        Guard l(cacheShard.lock);
+        auto cached = cacheShard.cache.get(cacheKey);
+        if (cached)
+        {
+            ++m_hit;
+            return copyEntries(*cached);
+        }
+    }
+
+    ++m_miss;
+    uint64_t seq = m_commitSeq.load();
+    auto entries = m_backend->select(hash, num, table, key);
+    if (entries && (seq & 1) == 0)
+    {
+        auto cached = copyEntries(entries);
+        Guard l(cacheShard.lock);
+        if (m_commitSeq.load() == seq)
+        {
+            put(cacheShard, cacheKey, cached);
+        }
+    }
+    return entries;
+}
+
+std::vector<Entries::Ptr> CachedStorage::batchSelect(
+    h256 hash, int num, std::vector<TableKey> const& keys)
+{
+    return fetch(hash, num, keys, true);
+}
+
+void CachedStorage::prefetch(h256 hash, int num, std::vector<TableKey> const& keys)
+{
+    fetch(hash, num, keys, false);
+}
+
+std::vector<Entries::Ptr> CachedStorage::fetch(
+    h256 hash, int num, std::vector<TableKey> const& keys, bool _copy)
+{
+    std::vector<Entries::Ptr> result(keys.size());
+    std::vector<size_t> misses;
+    std::vector<TableKey> missKeys;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        auto cacheKey = CachedStorage::cacheKey(keys[i].table, keys[i].key);
+        auto& cacheShard = shard(cacheKey);
+        Guard l(cacheShard.lock);
+        auto cached = cacheShard.cache.get(cacheKey);
+        if (cached)
+        {
+            ++m_hit;
+            result[i] = _copy ? copyEntries(*cached) : *cached;
+        }
+        else
+        {
+            misses.push_back(i);
+            missKeys.push_back(keys[i]);
+        }
+    }
+    if (misses.empty())
+    {
+        return result;
+    }
+
+    m_miss += misses.size();
+    uint64_t seq = m_commitSeq.load();
+    auto missed = m_backend->batchSelect(hash, num, missKeys);
+    for (size_t j = 0; j < misses.size(); ++j)
+    {
+        auto& entries = missed[j];
+        if (!entries)
+        {
+            continue;
+        }
+        auto cached = _copy ? copyEntries(entries) : entries;
+        if ((seq & 1) == 0)
+        {
+            auto cacheKey = CachedStorage::cacheKey(missKeys[j].table, missKeys[j].key);
+            auto& cacheShard = shard(cacheKey);
+            Guard l(cacheShard.lock);
+            if (m_commitSeq.load() == seq)
+            {
+                put(cacheShard, cacheKey, cached);
+            }
+        }
+        result[misses[j]] = entries;
+    }
+    return result;
+}
+
+size_t CachedStorage::commit(
+    h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash)
+{
+    Guard commitGuard(m_commitLock);
+    ++m_commitSeq;
+    size_t total = 0;
+    try
+    {
+        total = m_backend->commit(hash, num, datas, blockHash);
+    }
+    catch (...)
+    {
+        // the backend state is unknown, drop everything touched by this commit
+        for (auto const& tableData : datas)
+        {
+            for (auto const& dataIt : tableData->data)
+            {
+                auto cacheKey = CachedStorage::cacheKey(tableData->tableName, dataIt.first);
+                auto& cacheShard = shard(cacheKey);
+                Guard l(cacheShard.lock);
+                cacheShard.cache.erase(cacheKey);
+            }
+        }
+        ++m_commitSeq;
+        throw;
+    }
+
+    // keep the cache identical to what the backend returns for the committed rows
+    for (auto const& tableData : datas)
+    {
+        for (auto const& dataIt : tableData->data)
+        {
+            auto cacheKey = CachedStorage::cacheKey(tableData->tableName, dataIt.first);
+            auto& cacheShard = shard(cacheKey);
+            if (dataIt.second->size() == 0u)
+            {
+                // empty lists are not written by the backend
+                Guard l(cacheShard.lock);
+                cacheShard.cache.erase(cacheKey);
+                continue;
+            }
+
+            auto entries = committedEntries(dataIt.second, hash, num);
+            Guard l(cacheShard.lock);
+            put(cacheShard, cacheKey, entries);
+        }
+    }
+    ++m_commitSeq;
+
+    auto current = stats();
+    STORAGE_LOG(DEBUG) << "[#CachedStorage] commit [num/hit/miss/keys/memory]: " << num << "/"
+                       << current.hit << "/" << current.miss << "/" << current.size << "/"
+                       << current.memory;
+    return total;
+}
+
+bool CachedStorage::onlyDirty()
+{
+    return m_backend->onlyDirty();
+}
+
+int64_t CachedStorage::pendingNumber()
+{
+    return m_backend->pendingNumber();
+}
+
+void CachedStorage::setPersistHandler(std::function<void(int64_t)> _handler)
+{
+    m_backend->setPersistHandler(_handler);
+}
+
+CachedStorage::Stats CachedStorage::stats() const
+{
+    Stats stats;
+    stats.hit = m_hit.load();
+    stats.miss = m_miss.load();
+    stats.capacity = m_shardCapacity * m_shards.size();
+    for (auto const& cacheShard : m_shards)
+    {
+        Guard l(cacheShard->lock);
+        stats.size += cacheShard->cache.size();
+        stats.memory += cacheShard->cache.memory();
+    }
+    return stats;
+}
+
+CachedStorage::Shard& CachedStorage::shard(const std::string& cacheKey)
+{
+    return *m_shards[std::hash<std::string>()(cacheKey) % m_shards.size()];
+}
+
+void CachedStorage::put(Shard& cacheShard, const std::string& cacheKey, Entries::Ptr entries)
+{
+    cacheShard.cache.put(cacheKey, entries, estimateMemory(cacheKey, entries));
+}
+
+std::string CachedStorage::cacheKey(const std::string& table, const std::string& key)
+{
+    std::string cacheKey;
+    cacheKey.reserve(table.size() + key.size() + 1);
+    cacheKey.append(table).push_back('\0');
+    cacheKey.append(key);
+    return cacheKey;
+}
+
+size_t CachedStorage::estimateMemory(const std::string& cacheKey, Entries::Ptr entries)
+{
+    /// rough per object overhead of the map nodes and shared_ptr control blocks
+    const size_t c_overhead = 64;
+    size_t memory = cacheKey.size() + c_overhead * 2;
+    for (size_t i = 0; i < entries->size(); ++i)
+    {
+        memory += c_overhead;
+        entries->get(i)->forEachField(
+            [&memory](const std::string& name, const std::string& value) {
+                memory += name.size() + value.size() + c_overhead;
+            });
+    }
+    return memory;
+}
@@ -0,0 +1,106 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file CachedStorage.h
+ *  @author agent
+ *  @date 20261018
+ */
+#pragma once
+
+#include "Storage.h"
+#include <libdevcore/Guards.h>
+#include <libdevcore/LRUCache.h>
+#include <atomic>
+
+namespace dev
+{
+namespace storage
+{
+/**
+ * Storage decorator which keeps the latest committed rows of hot (table, key)
+ * pairs in a bounded, sharded LRU cache shared by every MemoryTableFactory.
+ *
+ * MemoryTable modifies the entries it selects in place, so the cache never
+ * hands out its own objects: select() returns copies and commit() stores
+ * copies of the committed rows (write-through).
+ */
+class CachedStorage : public Storage
+{
+public:
+    typedef std::shared_ptr<CachedStorage> Ptr;
+
+    struct Stats
+    {
+        uint64_t hit = 0;
+        uint64_t miss = 0;
+        uint64_t size = 0;      ///< cached keys
+        uint64_t memory = 0;    ///< estimated bytes held by the cache
+        uint64_t capacity = 0;  ///< memory limit in bytes
+    };
+
+    CachedStorage(Storage::Ptr _backend, size_t _capacity, size_t _shardCount = 16);
+    virtual ~CachedStorage(){};
+
+    virtual Entries::Ptr select(
+        h256 hash, int num, const std::string& table, const std::string& key) override;
+    /// the cache misses are read by a single batch select of the backend
+    virtual std::vector<Entries::Ptr> batchSelect(
+        h256 hash, int num, std::vector<TableKey> const& keys) override;
+    virtual void prefetch(h256 hash, int num, std::vector<TableKey> const& keys) override;
+    virtual size_t commit(
+        h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash) override;
+    virtual bool onlyDirty() override;
+    virtual int64_t pendingNumber() override;
+    virtual void setPersistHandler(std::function<void(int64_t)> _handler) override;
+
+    Storage::Ptr backend() const { return m_backend; }
+    Stats stats() const;
+
+private:
+    struct Shard
+    {
+        explicit Shard(size_t _capacity) : cache(_capacity) {}
+        mutable Mutex lock;
+        LRUCache<std::string, Entries::Ptr> cache;
+    };
+
+    /// the cached rows of the keys, the misses are read from the backend and cached, the rows
+    /// are the cached objects if _copy is false
+    std::vector<Entries::Ptr> fetch(
+        h256 hash, int num, std::vector<TableKey> const& keys, bool _copy);
+    Shard& shard(const std::string& cacheKey);
+    /// insert or replace, caller holds the shard lock
+    void put(Shard& shard, const std::string& cacheKey, Entries::Ptr entries);
+
+    static std::string cacheKey(const std::string& table, const std::string& key);
+    static size_t estimateMemory(const std::string& cacheKey, Entries::Ptr entries);
+
+    Storage::Ptr m_backend;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    size_t m_shardCapacity;
+
+    /// odd while a commit is in flight, a select only fills the cache when no
+    /// commit started or finished between its backend read and its insert
+    std::atomic<uint64_t> m_commitSeq = {0};
+    Mutex m_commitLock;
+
+    std::atomic<uint64_t> m_hit = {0};
+    std::atomic<uint64_t> m_miss = {0};
+};
+
+}  // namespace storage
+
+}  // namespace dev
@@ -39,6 +39,7 @@ const std::string SYS_VALUE = "value";
 const std::string SYS_TX_HASH_2_BLOCK = "_sys_tx_hash_2_block_";
 const std::string SYS_NUMBER_2_HASH = "_sys_number_2_hash_";
 const std::string SYS_HASH_2_BLOCK = "_sys_hash_2_block_";
+const std::string SYS_BLOCK_2_NONCES = "_sys_block_2_nonces_";
 const std::string SYS_CNS = "_sys_cns_";
 const std::string SYS_CONFIG = "_sys_config_";
 const std::string SYS_ACCESS_TABLE = "_sys_table_access_";
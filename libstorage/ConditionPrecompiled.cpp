@@ -40,19 +40,17 @@ const char* const CONDITION_METHOD_NE_STR_STR = "NE(string,string)";
 const char* const CONDITION_METHOD_LIMIT_INT = "limit(int256)";
 const char* const CONDITION_METHOD_LIMIT_2INT = "limit(int256,int256)";
 
-ConditionPrecompiled::ConditionPrecompiled()
-{
-    name2Selector[CONDITION_METHOD_EQ_STR_INT] = getFuncSelector(CONDITION_METHOD_EQ_STR_INT);
-    name2Selector[CONDITION_METHOD_EQ_STR_STR] = getFuncSelector(CONDITION_METHOD_EQ_STR_STR);
-    name2Selector[CONDITION_METHOD_GE_STR_INT] = getFuncSelector(CONDITION_METHOD_GE_STR_INT);
-    name2Selector[CONDITION_METHOD_GT_STR_INT] = getFuncSelector(CONDITION_METHOD_GT_STR_INT);
-    name2Selector[CONDITION_METHOD_LE_STR_INT] = getFuncSelector(CONDITION_METHOD_LE_STR_INT);
-    name2Selector[CONDITION_METHOD_LT_STR_INT] = getFuncSelector(CONDITION_METHOD_LT_STR_INT);
-    name2Selector[CONDITION_METHOD_NE_STR_INT] = getFuncSelector(CONDITION_METHOD_NE_STR_INT);
-    name2Selector[CONDITION_METHOD_NE_STR_STR] = getFuncSelector(CONDITION_METHOD_NE_STR_STR);
-    name2Selector[CONDITION_METHOD_LIMIT_INT] = getFuncSelector(CONDITION_METHOD_LIMIT_INT);
-    name2Selector[CONDITION_METHOD_LIMIT_2INT] = getFuncSelector(CONDITION_METHOD_LIMIT_2INT);
-}
+/// the selectors are the same for every instance, computed once
+const uint32_t CONDITION_METHOD_EQ_STR_INT_SELECTOR = getFuncSelector(CONDITION_METHOD_EQ_STR_INT);
+const uint32_t CONDITION_METHOD_EQ_STR_STR_SELECTOR = getFuncSelector(CONDITION_METHOD_EQ_STR_STR);
+const uint32_t CONDITION_METHOD_GE_STR_INT_SELECTOR = getFuncSelector(CONDITION_METHOD_GE_STR_INT);
+const uint32_t CONDITION_METHOD_GT_STR_INT_SELECTOR = getFuncSelector(CONDITION_METHOD_GT_STR_INT);
+const uint32_t CONDITION_METHOD_LE_STR_INT_SELECTOR = getFuncSelector(CONDITION_METHOD_LE_STR_INT);
+const uint32_t CONDITION_METHOD_LT_STR_INT_SELECTOR = getFuncSelector(CONDITION_METHOD_LT_STR_INT);
+const uint32_t CONDITION_METHOD_NE_STR_INT_SELECTOR = getFuncSelector(CONDITION_METHOD_NE_STR_INT);
+const uint32_t CONDITION_METHOD_NE_STR_STR_SELECTOR = getFuncSelector(CONDITION_METHOD_NE_STR_STR);
+const uint32_t CONDITION_METHOD_LIMIT_INT_SELECTOR = getFuncSelector(CONDITION_METHOD_LIMIT_INT);
+const uint32_t CONDITION_METHOD_LIMIT_2INT_SELECTOR = getFuncSelector(CONDITION_METHOD_LIMIT_2INT);
 
 std::string ConditionPrecompiled::toString(std::shared_ptr<ExecutiveContext>)
 {
@@ -75,7 +73,7 @@ bytes ConditionPrecompiled::call(
     bytes out;
 
     assert(m_condition);
-    if (func == name2Selector[CONDITION_METHOD_EQ_STR_INT])
+    if (func == CONDITION_METHOD_EQ_STR_INT_SELECTOR)
     {
         // EQ(string,int256)
         std::string str;
@@ -84,7 +82,7 @@ bytes ConditionPrecompiled::call(
 
         m_condition->EQ(str, boost::lexical_cast<std::string>(num));
     }
-    else if (func == name2Selector[CONDITION_METHOD_EQ_STR_STR])
+    else if (func == CONDITION_METHOD_EQ_STR_STR_SELECTOR)
     {  // EQ(string,string)
         std::string str;
         std::string value;
@@ -92,7 +90,7 @@ bytes ConditionPrecompiled::call(
 
         m_condition->EQ(str, value);
     }
-    else if (func == name2Selector[CONDITION_METHOD_GE_STR_INT])
+    else if (func == CONDITION_METHOD_GE_STR_INT_SELECTOR)
     {  // GE(string,int256)
         std::string str;
         u256 value;
@@ -100,7 +98,7 @@ bytes ConditionPrecompiled::call(
 
         m_condition->GE(str, boost::lexical_cast<std::string>(value));
     }
-    else if (func == name2Selector[CONDITION_METHOD_GT_STR_INT])
+    else if (func == CONDITION_METHOD_GT_STR_INT_SELECTOR)
     {  // GT(string,int256)
         std::string str;
         u256 value;
@@ -108,7 +106,7 @@ bytes ConditionPrecompiled::call(
 
         m_condition->GT(str, boost::lexical_cast<std::string>(value));
     }
-    else if (func == name2Selector[CONDITION_METHOD_LE_STR_INT])
+    else if (func == CONDITION_METHOD_LE_STR_INT_SELECTOR)
     {  // LE(string,int256)
         std::string str;
         u256 value;
@@ -116,7 +114,7 @@ bytes ConditionPrecompiled::call(
 
         m_condition->LE(str, boost::lexical_cast<std::string>(value));
     }
-    else if (func == name2Selector[CONDITION_METHOD_LT_STR_INT])
+    else if (func == CONDITION_METHOD_LT_STR_INT_SELECTOR)
     {  // LT(string,int256)
         std::string str;
         u256 value;
@@ -124,7 +122,7 @@ bytes ConditionPrecompiled::call(
 
         m_condition->LT(str, boost::lexical_cast<std::string>(value));
     }
-    else if (func == name2Selector[CONDITION_METHOD_NE_STR_INT])
+    else if (func == CONDITION_METHOD_NE_STR_INT_SELECTOR)
     {  // NE(string,int256)
         std::string str;
         u256 num;
@@ -132,7 +130,7 @@ bytes ConditionPrecompiled::call(
 
         m_condition->NE(str, boost::lexical_cast<std::string>(num));
     }
-    else if (func == name2Selector[CONDITION_METHOD_NE_STR_STR])
+    else if (func == CONDITION_METHOD_NE_STR_STR_SELECTOR)
     {  // NE(string,string)
         std::string str;
         std::string value;
@@ -140,14 +138,14 @@ bytes ConditionPrecompiled::call(
 
         m_condition->NE(str, value);
     }
-    else if (func == name2Selector[CONDITION_METHOD_LIMIT_INT])
+    else if (func == CONDITION_METHOD_LIMIT_INT_SELECTOR)
     {  // limit(int256)
         u256 num;
         abi.abiOut(data, num);
 
         m_condition->limit(num.convert_to<size_t>());
     }
-    else if (func == name2Selector[CONDITION_METHOD_LIMIT_2INT])
+    else if (func == CONDITION_METHOD_LIMIT_2INT_SELECTOR)
     {  // limit(int256,int256)
         u256 offset;
         u256 size;
@@ -0,0 +1,219 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file EntriesCodec.cpp
+ *  @author agent
+ *  @date 20261018
+ */
+
+#include "EntriesCodec.h"
+#include "Common.h"
+#include "StorageException.h"
+#include <map>
+
+using namespace dev;
+using namespace dev::storage;
+
+namespace
+{
+const std::string c_hashField = "_hash_";
+const std::string c_numField = "_num_";
+
+inline void putVarint(std::string& _out, uint64_t _value)
+{
+    while (_value >= 0x80)
+    {
+        _out.push_back(char((_value & 0x7f) | 0x80));
+        _value >>= 7;
+    }
+    _out.push_back(char(_value));
+}
+
+inline void putBytes(std::string& _out, std::string const& _value)
+{
+    putVarint(_out, _value.size());
+    _out.append(_value);
+}
+
+class Reader
+{
+public:
+    Reader(std::string const& _value) : m_pos(_value.data()), m_end(_value.data() + _value.size())
+    {}
+
+    uint64_t varint()
+    {
+        uint64_t result = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            if (m_pos >= m_end)
+            {
+                break;
+            }
+            uint64_t byte = uint8_t(*m_pos++);
+            result |= (byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+            {
+                return result;
+            }
+        }
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Decode entries failed: bad varint"));
+    }
+
+    const char* take(uint64_t _size)
+    {
+        if (uint64_t(m_end - m_pos) < _size)
+        {
+            BOOST_THROW_EXCEPTION(StorageException(-1, "Decode entries failed: truncated value"));
+        }
+        const char* data = m_pos;
+        m_pos += _size;
+        return data;
+    }
+
+    std::string bytes(uint64_t _size) { return std::string(take(_size), _size); }
+
+    /// reject counts which can't be backed by the remaining bytes
+    uint64_t count()
+    {
+        uint64_t value = varint();
+        if (value > uint64_t(m_end - m_pos))
+        {
+            BOOST_THROW_EXCEPTION(StorageException(-1, "Decode entries failed: bad count"));
+        }
+        return value;
+    }
+
+private:
+    const char* m_pos;
+    const char* m_end;
+};
+}  // namespace
+
+std::string EntriesCodec::encode(
+    Entries::Ptr _entries, TableInfo::Ptr _tableInfo, h256 const& _hash, int64_t _num)
+{
+    std::vector<std::string> schema;
+    std::map<std::string, size_t> schemaIndex;
+    auto addField = [&](std::string const& _field) {
+        if (_field == c_hashField || _field == c_numField)
+        {
+            return;
+        }
+        if (schemaIndex.insert(std::make_pair(_field, schema.size())).second)
+        {
+            schema.push_back(_field);
+        }
+    };
+
+    if (_tableInfo)
+    {
+        for (auto const& field : _tableInfo->fields)
+        {
+            addField(field);
+        }
+    }
+    for (size_t i = 0; i < _entries->size(); ++i)
+    {
+        _entries->get(i)->forEachField(
+            [&addField](const std::string& name, const std::string&) { addField(name); });
+    }
+
+    std::string out;
+    out.reserve(64 + _entries->size() * schema.size() * 8);
+    out.push_back(char(c_magic));
+    out.push_back(char(c_version));
+    putVarint(out, uint64_t(_num));
+    out.append(reinterpret_cast<const char*>(_hash.data()), h256::size);
+
+    putVarint(out, schema.size());
+    for (auto const& field : schema)
+    {
+        putBytes(out, field);
+    }
+
+    putVarint(out, _entries->size());
+    for (size_t i = 0; i < _entries->size(); ++i)
+    {
+        auto entry = _entries->get(i);
+        for (auto const& field : schema)
+        {
+            auto value = entry->findField(field);
+            if (!value)
+            {
+                putVarint(out, 0);
+                continue;
+            }
+            putVarint(out, value->size() + 1);
+            out.append(*value);
+        }
+    }
+
+    return out;
+}
+
+Entries::Ptr EntriesCodec::decode(std::string const& _value)
+{
+    if (!isBinary(_value))
+    {
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Decode entries failed: bad magic"));
+    }
+
+    Reader reader(_value);
+    reader.take(1);
+    auto version = uint8_t(*reader.take(1));
+    if (version != c_version)
+    {
+        BOOST_THROW_EXCEPTION(StorageException(
+            -1, "Decode entries failed: unsupported version " + std::to_string(version)));
+    }
+
+    auto num = std::to_string(int64_t(reader.varint()));
+    auto hash =
+        h256(reinterpret_cast<const byte*>(reader.take(h256::size)), h256::ConstructFromPointer)
+            .hex();
+
+    std::vector<std::string> schema(reader.count());
+    for (auto& field : schema)
+    {
+        field = reader.bytes(reader.varint());
+    }
+
+    Entries::Ptr entries = std::make_shared<Entries>();
+    uint64_t rows = reader.count();
+    for (uint64_t i = 0; i < rows; ++i)
+    {
+        Entry::Ptr entry = std::make_shared<Entry>();
+        for (auto const& field : schema)
+        {
+            uint64_t size = reader.varint();
+            if (size > 0)
+            {
+                entry->setField(field, reader.bytes(size - 1));
+            }
+        }
+        entry->setField(c_hashField, hash);
+        entry->setField(c_numField, num);
+
+        if (entry->getStatus() == Entry::Status::NORMAL)
+        {
+            entry->setDirty(false);
+            entries->addEntry(entry);
+        }
+    }
+
+    return entries;
+}
@@ -0,0 +1,67 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file EntriesCodec.h
+ *  @author agent
+ *  @date 20261018
+ */
+#pragma once
+
+#include "Table.h"
+#include <libdevcore/FixedHash.h>
+#include <string>
+
+namespace dev
+{
+namespace storage
+{
+/**
+ * Binary value format of one (table, key) row list:
+ *
+ *   magic(1) | version(1) | _num_(varint) | _hash_(32)
+ *   | fieldCount(varint) | fieldName(varint len + bytes) * fieldCount
+ *   | rowCount(varint) | row * rowCount
+ *
+ * Every row stores one slot per schema field in schema order. A slot is
+ * varint(len + 1) followed by the bytes of the value, 0 marks an absent field.
+ * The schema is written once per key, so field names and the _hash_/_num_
+ * columns are no longer repeated per row as in the legacy json values.
+ */
+class EntriesCodec
+{
+public:
+    static const uint8_t c_magic = 0xfb;
+    static const uint8_t c_version = 1;
+
+    /// encode _entries, the schema is taken from _tableInfo (may be null),
+    /// fields outside of the schema are appended to it
+    static std::string encode(Entries::Ptr _entries, TableInfo::Ptr _tableInfo,
+        h256 const& _hash, int64_t _num);
+
+    /// decode a binary value, rows marked as deleted are skipped
+    /// throws StorageException when the value is malformed
+    static Entries::Ptr decode(std::string const& _value);
+
+    /// check whether _value is written in the binary format (legacy values are json)
+    static bool isBinary(std::string const& _value)
+    {
+        return _value.size() >= 2 && uint8_t(_value[0]) == c_magic;
+    }
+};
+
+}  // namespace storage
+
+}  // namespace dev
@@ -30,11 +30,9 @@ using namespace dev::storage;
 const char* const ENTRYIES_METHOD_GET_INT = " get(int256)";
 const char* const ENTRYIES_METHOD_SIZE = "size()";
 
-EntriesPrecompiled::EntriesPrecompiled()
-{
-    name2Selector[ENTRYIES_METHOD_GET_INT] = getFuncSelector(ENTRYIES_METHOD_GET_INT);
-    name2Selector[ENTRYIES_METHOD_SIZE] = getFuncSelector(ENTRYIES_METHOD_SIZE);
-}
+/// the selectors are the same for every instance, computed once
+const uint32_t ENTRYIES_METHOD_GET_INT_SELECTOR = getFuncSelector(ENTRYIES_METHOD_GET_INT);
+const uint32_t ENTRYIES_METHOD_SIZE_SELECTOR = getFuncSelector(ENTRYIES_METHOD_SIZE);
 
 std::string dev::blockverifier::EntriesPrecompiled::toString(std::shared_ptr<ExecutiveContext>)
 {
@@ -55,7 +53,7 @@ bytes dev::blockverifier::EntriesPrecompiled::call(
 
     bytes out;
 
-    if (func == name2Selector[ENTRYIES_METHOD_GET_INT])
+    if (func == ENTRYIES_METHOD_GET_INT_SELECTOR)
     {  // get(int256)
         u256 num;
         abi.abiOut(data, num);
@@ -63,11 +61,11 @@ bytes dev::blockverifier::EntriesPrecompiled::call(
         auto entry = m_entries->get(num.convert_to<size_t>());
         EntryPrecompiled::Ptr entryPrecompiled = std::make_shared<EntryPrecompiled>();
         entryPrecompiled->setEntry(entry);
-        Address address = context->registerPrecompiled(entryPrecompiled);
+        Address address = context->registerTransientPrecompiled(entryPrecompiled);
 
         out = abi.abiIn("", address);
     }
-    else if (func == name2Selector[ENTRYIES_METHOD_SIZE])
+    else if (func == ENTRYIES_METHOD_SIZE_SELECTOR)
     {  // size()
         u256 c = m_entries->size();
 
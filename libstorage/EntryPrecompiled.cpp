@@ -34,16 +34,14 @@ const char* const ENTRYIY_METHOD_GETA_STR = "getAddress(string)";
 const char* const ENTRYIY_METHOD_GETB_STR = "getBytes64(string)";
 const char* const ENTRYIY_METHOD_GETB_STR32 = "getBytes32(string)";
 
-EntryPrecompiled::EntryPrecompiled()
-{
-    name2Selector[ENTRYIES_METENTRYIY_METHOD_GETI_STR] =
-        getFuncSelector(ENTRYIES_METENTRYIY_METHOD_GETI_STR);
-    name2Selector[ENTRYIY_METHOD_SET_STR_INT] = getFuncSelector(ENTRYIY_METHOD_SET_STR_INT);
-    name2Selector[ENTRYIY_METHOD_SET_STR_STR] = getFuncSelector(ENTRYIY_METHOD_SET_STR_STR);
-    name2Selector[ENTRYIY_METHOD_GETA_STR] = getFuncSelector(ENTRYIY_METHOD_GETA_STR);
-    name2Selector[ENTRYIY_METHOD_GETB_STR] = getFuncSelector(ENTRYIY_METHOD_GETB_STR);
-    name2Selector[ENTRYIY_METHOD_GETB_STR32] = getFuncSelector(ENTRYIY_METHOD_GETB_STR32);
-}
+/// the selectors are the same for every instance, computed once
+const uint32_t ENTRYIES_METENTRYIY_METHOD_GETI_STR_SELECTOR =
+    getFuncSelector(ENTRYIES_METENTRYIY_METHOD_GETI_STR);
+const uint32_t ENTRYIY_METHOD_SET_STR_INT_SELECTOR = getFuncSelector(ENTRYIY_METHOD_SET_STR_INT);
+const uint32_t ENTRYIY_METHOD_SET_STR_STR_SELECTOR = getFuncSelector(ENTRYIY_METHOD_SET_STR_STR);
+const uint32_t ENTRYIY_METHOD_GETA_STR_SELECTOR = getFuncSelector(ENTRYIY_METHOD_GETA_STR);
+const uint32_t ENTRYIY_METHOD_GETB_STR_SELECTOR = getFuncSelector(ENTRYIY_METHOD_GETB_STR);
+const uint32_t ENTRYIY_METHOD_GETB_STR32_SELECTOR = getFuncSelector(ENTRYIY_METHOD_GETB_STR32);
 
 std::string EntryPrecompiled::toString(std::shared_ptr<ExecutiveContext>)
 {
@@ -65,7 +63,7 @@ bytes EntryPrecompiled::call(
 
     bytes out;
 
-    if (func == name2Selector[ENTRYIES_METENTRYIY_METHOD_GETI_STR])
+    if (func == ENTRYIES_METENTRYIY_METHOD_GETI_STR_SELECTOR)
     {  // getInt(string)
         std::string str;
         abi.abiOut(data, str);
@@ -75,7 +73,7 @@ bytes EntryPrecompiled::call(
         u256 num = boost::lexical_cast<u256>(value);
         out = abi.abiIn("", num);
     }
-    else if (func == name2Selector[ENTRYIY_METHOD_SET_STR_INT])
+    else if (func == ENTRYIY_METHOD_SET_STR_INT_SELECTOR)
     {  // set(string,int256)
         std::string str;
         u256 value;
@@ -83,7 +81,7 @@ bytes EntryPrecompiled::call(
 
         m_entry->setField(str, boost::lexical_cast<std::string>(value));
     }
-    else if (func == name2Selector[ENTRYIY_METHOD_SET_STR_STR])
+    else if (func == ENTRYIY_METHOD_SET_STR_STR_SELECTOR)
     {  // set(string,string)
         std::string str;
         std::string value;
@@ -91,7 +89,7 @@ bytes EntryPrecompiled::call(
 
         m_entry->setField(str, value);
     }
-    else if (func == name2Selector[ENTRYIY_METHOD_GETA_STR])
+    else if (func == ENTRYIY_METHOD_GETA_STR_SELECTOR)
     {  // getAddress(string)
         std::string str;
         abi.abiOut(data, str);
@@ -100,7 +98,7 @@ bytes EntryPrecompiled::call(
         Address ret = Address(value);
         out = abi.abiIn("", ret);
     }
-    else if (func == name2Selector[ENTRYIY_METHOD_GETB_STR])
+    else if (func == ENTRYIY_METHOD_GETB_STR_SELECTOR)
     {  // getBytes64(string)
         std::string str;
         abi.abiOut(data, str);
@@ -112,7 +110,7 @@ bytes EntryPrecompiled::call(
 
         out = abi.abiIn("", ret);
     }
-    else if (func == name2Selector[ENTRYIY_METHOD_GETB_STR32])
+    else if (func == ENTRYIY_METHOD_GETB_STR32_SELECTOR)
     {  //"getBytes32(string)"
         std::string str;
         abi.abiOut(data, str);
@@ -20,11 +20,14 @@
  */
 
 #include "LevelDBStorage.h"
+#include "EntriesCodec.h"
 #include "Table.h"
 #include <leveldb/db.h>
 #include <leveldb/write_batch.h>
 #include <libdevcore/easylog.h>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 using namespace dev;
 using namespace dev::storage;
@@ -34,46 +37,76 @@ Entries::Ptr LevelDBStorage::select(
 {
     try
     {
-        std::string entryKey = table + "_" + key;
-        std::string value;
         ReadGuard l(m_remoteDBMutex);
-        auto s = m_db->Get(leveldb::ReadOptions(), leveldb::Slice(entryKey), &value);
-        if (!s.ok() && !s.IsNotFound())
-        {
-            STORAGE_LEVELDB_LOG(ERROR) << "Query leveldb failed:" + s.ToString();
-
-            BOOST_THROW_EXCEPTION(StorageException(-1, "Query leveldb exception:" + s.ToString()));
-        }
+        return get(leveldb::ReadOptions(), table + "_" + key);
+    }
+    catch (std::exception& e)
+    {
+        STORAGE_LEVELDB_LOG(ERROR)
+            << "Query leveldb exception:" << boost::diagnostic_information(e);
 
-        Entries::Ptr entries = std::make_shared<Entries>();
-        if (!s.IsNotFound())
-        {
-            // parse json
-            std::stringstream ssIn;
-            ssIn << value;
+        BOOST_THROW_EXCEPTION(e);
+    }
 
-            Json::Value valueJson;
-            ssIn >> valueJson;
+    return Entries::Ptr();
+}
 
-            Json::Value values = valueJson["values"];
-            for (auto it = values.begin(); it != values.end(); ++it)
+std::vector<Entries::Ptr> LevelDBStorage::batchSelect(
+    h256 hash, int num, std::vector<TableKey> const& keys)
+{
+    /// fewer keys are read by the calling thread alone
+    const size_t c_keysPerThread = 16;
+    std::vector<Entries::Ptr> result(keys.size());
+    try
+    {
+        ReadGuard l(m_remoteDBMutex);
+        leveldb::ReadOptions options;
+        options.snapshot = m_db->GetSnapshot();
+
+        size_t chunks = std::min(m_readThreads + 1, (keys.size() + c_keysPerThread - 1) /
+                                                        c_keysPerThread);
+        chunks = std::max(chunks, size_t(1));
+        std::vector<std::exception_ptr> errors(chunks);
+        auto read = [&](size_t chunk) {
+            try
             {
-                Entry::Ptr entry = std::make_shared<Entry>();
-
-                for (auto valueIt = it->begin(); valueIt != it->end(); ++valueIt)
+                for (size_t i = chunk; i < keys.size(); i += chunks)
                 {
-                    entry->setField(valueIt.key().asString(), valueIt->asString());
-                }
-
-                if (entry->getStatus() == Entry::Status::NORMAL)
-                {
-                    entry->setDirty(false);
-                    entries->addEntry(entry);
+                    result[i] = get(options, keys[i].table + "_" + keys[i].key);
                 }
             }
+            catch (...)
+            {
+                errors[chunk] = std::current_exception();
+            }
+        };
+
+        std::mutex lock;
+        std::condition_variable finished;
+        size_t pending = chunks - 1;
+        for (size_t chunk = 1; chunk < chunks; ++chunk)
+        {
+            m_readPool->enqueue([&, chunk]() {
+                read(chunk);
+                std::lock_guard<std::mutex> l(lock);
+                --pending;
+                finished.notify_all();
+            });
         }
+        read(0);
+        {
+            std::unique_lock<std::mutex> l(lock);
+            finished.wait(l, [&]() { return pending == 0; });
+        }
+        m_db->ReleaseSnapshot(options.snapshot);
 
-        return entries;
+        for (auto& error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
     }
     catch (std::exception& e)
     {
@@ -83,7 +116,31 @@ Entries::Ptr LevelDBStorage::select(
         BOOST_THROW_EXCEPTION(e);
     }
 
-    return Entries::Ptr();
+    return result;
+}
+
+Entries::Ptr LevelDBStorage::get(leveldb::ReadOptions const& options, const std::string& entryKey)
+{
+    std::string value;
+    auto s = m_db->Get(options, leveldb::Slice(entryKey), &value);
+    if (!s.ok() && !s.IsNotFound())
+    {
+        STORAGE_LEVELDB_LOG(ERROR) << "Query leveldb failed:" + s.ToString();
+
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Query leveldb exception:" + s.ToString()));
+    }
+
+    if (s.IsNotFound())
+    {
+        return std::make_shared<Entries>();
+    }
+
+    if (EntriesCodec::isBinary(value))
+    {
+        return EntriesCodec::decode(value);
+    }
+    // rows written before the binary codec was introduced
+    return decodeJson(value);
 }
 
 size_t LevelDBStorage::commit(
@@ -106,27 +163,12 @@ size_t LevelDBStorage::commit(
                     continue;
                 }
                 std::string entryKey = it->tableName + "_" + dataIt.first;
-                Json::Value entry;
-
-                for (size_t i = 0; i < dataIt.second->size(); ++i)
-                {
-                    Json::Value value;
-                    for (auto fieldIt : *(dataIt.second->get(i)->fields()))
-                    {
-                        value[fieldIt.first] = fieldIt.second;
-                    }
-                    value["_hash_"] = hash.hex();
-                    value["_num_"] = num;
-                    entry["values"].append(value);
-                }
+                std::string value = EntriesCodec::encode(dataIt.second, it->info, hash, num);
 
-                std::stringstream ssOut;
-                ssOut << entry;
-
-                batch->insertSlice(leveldb::Slice(entryKey), leveldb::Slice(ssOut.str()));
+                batch->insertSlice(leveldb::Slice(entryKey), leveldb::Slice(value));
                 ++total;
                 STORAGE_LEVELDB_LOG(TRACE)
-                    << "leveldb commit key:" << entryKey << " data size:" << ssOut.tellp();
+                    << "leveldb commit key:" << entryKey << " data size:" << value.size();
             }
         }
 
@@ -154,6 +196,35 @@ size_t LevelDBStorage::commit(
     return 0;
 }
 
+Entries::Ptr LevelDBStorage::decodeJson(const std::string& value)
+{
+    std::stringstream ssIn;
+    ssIn << value;
+
+    Json::Value valueJson;
+    ssIn >> valueJson;
+
+    Entries::Ptr entries = std::make_shared<Entries>();
+    Json::Value values = valueJson["values"];
+    for (auto it = values.begin(); it != values.end(); ++it)
+    {
+        Entry::Ptr entry = std::make_shared<Entry>();
+
+        for (auto valueIt = it->begin(); valueIt != it->end(); ++valueIt)
+        {
+            entry->setField(valueIt.key().asString(), valueIt->asString());
+        }
+
+        if (entry->getStatus() == Entry::Status::NORMAL)
+        {
+            entry->setDirty(false);
+            entries->addEntry(entry);
+        }
+    }
+
+    return entries;
+}
+
 bool LevelDBStorage::onlyDirty()
 {
     return false;
@@ -163,3 +234,13 @@ void LevelDBStorage::setDB(std::shared_ptr<dev::db::BasicLevelDB> db)
 {
     m_db = db;
 }
+
+void LevelDBStorage::setReadThreads(size_t _threadNum)
+{
+    m_readPool.reset();
+    m_readThreads = _threadNum;
+    if (m_readThreads > 0)
+    {
+        m_readPool.reset(new dev::ThreadPool("StorageRead", m_readThreads));
+    }
+}
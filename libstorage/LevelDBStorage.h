@@ -28,6 +28,7 @@
 #include <libdevcore/BasicLevelDB.h>
 #include <libdevcore/FixedHash.h>
 #include <libdevcore/Guards.h>
+#include <libdevcore/ThreadPool.h>
 
 namespace dev
 {
@@ -42,15 +43,25 @@ public:
 
     virtual Entries::Ptr select(
         h256 hash, int num, const std::string& table, const std::string& key) override;
+    /// reads the keys from a single snapshot, split over the read threads
+    virtual std::vector<Entries::Ptr> batchSelect(
+        h256 hash, int num, std::vector<TableKey> const& keys) override;
     virtual size_t commit(
         h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash) override;
     virtual bool onlyDirty() override;
 
     void setDB(std::shared_ptr<dev::db::BasicLevelDB> db);
+    /// threads reading and decoding the keys of a batch select besides the calling one
+    void setReadThreads(size_t _threadNum);
 
 private:
+    Entries::Ptr get(leveldb::ReadOptions const& options, const std::string& entryKey);
+    Entries::Ptr decodeJson(const std::string& value);
+
     std::shared_ptr<dev::db::BasicLevelDB> m_db;
     dev::SharedMutex m_remoteDBMutex;
+    std::unique_ptr<dev::ThreadPool> m_readPool;
+    size_t m_readThreads = 0;
 };
 
 }  // namespace storage
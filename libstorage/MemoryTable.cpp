@@ -25,7 +25,8 @@
 #include <libdevcore/easylog.h>
 #include <libdevcrypto/Hash.h>
 #include <boost/exception/diagnostic_information.hpp>
-#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <cstring>
 
 using namespace dev;
 using namespace dev::storage;
@@ -46,12 +47,7 @@ Entries::Ptr dev::storage::MemoryTable::select(const std::string& key, Condition
         {
             if (m_remoteDB)
             {
-                entries = m_remoteDB->select(m_blockHash, m_blockNum, m_tableInfo->name, key);
-
-                // STORAGE_LOG(TRACE)
-                // << m_tableInfo->name << " selects:" << entries->size() << " record(s)";
-
-                m_cache.insert(std::make_pair(key, entries));
+                entries = loadEntries(key);
             }
         }
         else
@@ -64,11 +60,12 @@ Entries::Ptr dev::storage::MemoryTable::select(const std::string& key, Condition
             STORAGE_LOG(DEBUG) << "Can't find data";
             return std::make_shared<Entries>();
         }
-        auto indexes = processEntries(entries, condition);
+        auto indexes = processEntries(key, entries, condition, m_exactConditions);
         Entries::Ptr resultEntries = std::make_shared<Entries>();
         for (auto i : indexes)
         {
-            resultEntries->addEntry(entries->get(i));
+            auto entry = entries->get(i);
+            resultEntries->addEntry(m_selectCopies ? std::make_shared<Entry>(*entry) : entry);
         }
         return resultEntries;
     }
@@ -100,11 +97,7 @@ int dev::storage::MemoryTable::update(
         {
             if (m_remoteDB)
             {
-                entries = m_remoteDB->select(m_blockHash, m_blockNum, m_tableInfo->name, key);
-
-                /// STORAGE_LOG(DEBUG) << "AMOPDB selects:" << entries->size() << " record(s)";
-
-                m_cache.insert(std::make_pair(key, entries));
+                entries = loadEntries(key);
             }
         }
         else
@@ -119,21 +112,22 @@ int dev::storage::MemoryTable::update(
             return 0;
         }
         checkFiled(entry);
-        auto indexes = processEntries(entries, condition);
+        auto indexes = processEntries(key, entries, condition);
         std::vector<Change::Record> records;
 
         for (auto i : indexes)
         {
             Entry::Ptr updateEntry = entries->get(i);
-            for (auto it : *(entry->fields()))
-            {
-                records.emplace_back(i, it.first, updateEntry->getField(it.first));
-                updateEntry->setField(it.first, it.second);
-            }
+            entry->forEachField([&](const std::string& name, const std::string& value) {
+                records.emplace_back(i, name, updateEntry->getField(name));
+                updateEntry->setField(name, value);
+            });
         }
         m_recorder(shared_from_this(), Change::Update, key, records);
 
         entries->setDirty(true);
+        m_dirtyKeys.insert(key);
+        ++m_changes;
 
         return indexes.size();
     }
@@ -166,11 +160,7 @@ int dev::storage::MemoryTable::insert(
         {
             if (m_remoteDB)
             {
-                entries = m_remoteDB->select(m_blockHash, m_blockNum, m_tableInfo->name, key);
-
-                /// STORAGE_LOG(DEBUG) << "AMOPDB selects:" << entries->size() << " record(s)";
-
-                m_cache.insert(std::make_pair(key, entries));
+                entries = loadEntries(key);
             }
         }
         else
@@ -178,9 +168,12 @@ int dev::storage::MemoryTable::insert(
             entries = it->second;
         }
         checkFiled(entry);
+        entry->setSchema(m_schema);
         Change::Record record(entries->size() + 1u);
         std::vector<Change::Record> value{record};
         m_recorder(shared_from_this(), Change::Insert, key, value);
+        m_dirtyKeys.insert(key);
+        ++m_changes;
         if (entries->size() == 0)
         {
             entries->addEntry(entry);
@@ -219,11 +212,7 @@ int dev::storage::MemoryTable::remove(
     {
         if (m_remoteDB)
         {
-            entries = m_remoteDB->select(m_blockHash, m_blockNum, m_tableInfo->name, key);
-
-            // STORAGE_LOG(DEBUG) << "AMOPDB selects:" << entries->size() << " record(s)";
-
-            m_cache.insert(std::make_pair(key, entries));
+            entries = loadEntries(key);
         }
     }
     else
@@ -231,7 +220,7 @@ int dev::storage::MemoryTable::remove(
         entries = it->second;
     }
 
-    auto indexes = processEntries(entries, condition);
+    auto indexes = processEntries(key, entries, condition);
 
     std::vector<Change::Record> records;
     for (auto i : indexes)
@@ -244,42 +233,65 @@ int dev::storage::MemoryTable::remove(
     m_recorder(shared_from_this(), Change::Remove, key, records);
 
     entries->setDirty(true);
+    m_dirtyKeys.insert(key);
+    ++m_changes;
 
     return indexes.size();
 }
 
 h256 dev::storage::MemoryTable::hash()
 {
+    if (m_rescanDirtyKeys)
+    {
+        m_dirtyKeys.clear();
+        for (auto& it : m_cache)
+        {
+            if (it.second && it.second->dirty())
+            {
+                m_dirtyKeys.insert(it.first);
+            }
+        }
+        m_rescanDirtyKeys = false;
+    }
+
+    // the clean rows don't take part in the hash, only the dirty keys are walked, in the order
+    // of m_cache. The entries handed out by select can be changed in place, so the hash of a
+    // dirty key is computed again on every call
     bytes data;
-    for (auto it : m_cache)
+    data.reserve(m_hashDataSize);
+    for (auto keyIt = m_dirtyKeys.begin(); keyIt != m_dirtyKeys.end();)
     {
-        if (it.second->dirty())
+        auto it = m_cache.find(*keyIt);
+        if (it == m_cache.end() || !it->second || !it->second->dirty())
+        {
+            // removed by a rollback
+            keyIt = m_dirtyKeys.erase(keyIt);
+            continue;
+        }
+        data.insert(data.end(), it->first.begin(), it->first.end());
+        for (size_t i = 0; i < it->second->size(); ++i)
         {
-            data.insert(data.end(), it.first.begin(), it.first.end());
-            for (size_t i = 0; i < it.second->size(); ++i)
+            auto entry = it->second->get(i);
+            if (entry->dirty())
             {
-                if (it.second->get(i)->dirty())
-                {
-                    for (auto fieldIt : *(it.second->get(i)->fields()))
+                entry->forEachField([&](const std::string& name, const std::string& value) {
+                    if (isHashField(name))
                     {
-                        if (isHashField(fieldIt.first))
-                        {
-                            data.insert(data.end(), fieldIt.first.begin(), fieldIt.first.end());
-                            data.insert(data.end(), fieldIt.second.begin(), fieldIt.second.end());
-                        }
+                        data.insert(data.end(), name.begin(), name.end());
+                        data.insert(data.end(), value.begin(), value.end());
                     }
-                }
+                });
             }
         }
+        ++keyIt;
     }
+    m_hashDataSize = data.size();
 
     if (data.empty())
     {
         return h256();
     }
 
-    std::string str(data.begin(), data.end());
-
     bytesConstRef bR(data.data(), data.size());
     h256 hash = dev::sha256(bR);
 
@@ -289,134 +301,331 @@ h256 dev::storage::MemoryTable::hash()
 void dev::storage::MemoryTable::clear()
 {
     m_cache.clear();
+    m_dirtyKeys.clear();
+    m_rescanDirtyKeys = false;
+    m_indexes.clear();
 }
 
 std::map<std::string, Entries::Ptr>* dev::storage::MemoryTable::data()
 {
+    // the caller may add rows, find the dirty keys again on the next hash
+    m_rescanDirtyKeys = true;
+    ++m_changes;
     return &m_cache;
 }
 
+Entries::Ptr MemoryTable::loadEntries(const std::string& key)
+{
+    auto entries = m_remoteDB->select(m_blockHash, m_blockNum, m_tableInfo->name, key);
+    m_cache.insert(std::make_pair(key, entries));
+    if (entries)
+    {
+        for (size_t i = 0; i < entries->size(); ++i)
+        {
+            entries->get(i)->setSchema(m_schema);
+        }
+    }
+    // rows read from the storage are dirty unless they are empty
+    if (entries && entries->dirty())
+    {
+        m_dirtyKeys.insert(key);
+    }
+    return entries;
+}
+
 void dev::storage::MemoryTable::setStateStorage(Storage::Ptr amopDB)
 {
     m_remoteDB = amopDB;
 }
 
-std::vector<size_t> MemoryTable::processEntries(Entries::Ptr entries, Condition::Ptr condition)
+namespace
 {
-    std::vector<size_t> indexes;
-    indexes.reserve(entries->size());
-    if (condition->getConditions()->empty())
+/// a decimal integer of any size, [sign]digits as accepted by boost::lexical_cast
+struct Decimal
+{
+    bool valid = false;
+    bool negative = false;
+    /// the digits without the leading zeros
+    const char* digits = nullptr;
+    size_t size = 0;
+
+    explicit Decimal(const std::string& _str)
     {
-        for (size_t i = 0; i < entries->size(); ++i)
-            indexes.emplace_back(i);
-        return indexes;
+        const char* it = _str.data();
+        const char* end = it + _str.size();
+        if (_str.empty())
+        {
+            // compared as 0
+            valid = true;
+            return;
+        }
+        if (*it == '-' || *it == '+')
+        {
+            negative = *it == '-';
+            ++it;
+        }
+        if (it == end)
+        {
+            return;
+        }
+        for (const char* c = it; c != end; ++c)
+        {
+            if (*c < '0' || *c > '9')
+            {
+                return;
+            }
+        }
+        while (it != end && *it == '0')
+        {
+            ++it;
+        }
+        valid = true;
+        digits = it;
+        size = end - it;
+        negative = negative && size > 0;
+    }
+
+    /// the values boost::lexical_cast<int> accepts, compared before storage.exactConditions
+    bool isInt() const
+    {
+        return size < 10 ||
+               (size == 10 &&
+                   std::memcmp(digits, negative ? "2147483648" : "2147483647", size) <= 0);
     }
 
-    for (size_t i = 0; i < entries->size(); ++i)
+    int compare(Decimal const& _other) const
     {
-        Entry::Ptr entry = entries->get(i);
-        if (processCondition(entry, condition))
+        if (negative != _other.negative)
+        {
+            return negative ? -1 : 1;
+        }
+        int c = 0;
+        if (size != _other.size)
+        {
+            c = size < _other.size ? -1 : 1;
+        }
+        else if (size > 0)
         {
-            indexes.push_back(i);
+            c = std::memcmp(digits, _other.digits, size);
         }
+        return negative ? -c : c;
     }
+};
 
-    return indexes;
-}
-
-bool dev::storage::MemoryTable::processCondition(Entry::Ptr entry, Condition::Ptr condition)
+/// a condition compiled once for all the rows it's applied to
+class Predicate
 {
-    try
+public:
+    Predicate(Condition::Ptr _condition, EntrySchema::Ptr _schema, bool _exact)
+      : m_schema(_schema), m_exact(_exact)
     {
-        for (auto it : *condition->getConditions())
+        auto conditions = _condition->getConditions();
+        m_terms.reserve(conditions->size());
+        for (auto& it : *conditions)
         {
-            if (entry->getStatus() == Entry::Status::DELETED)
-            {
-                return false;
-            }
+            Term term;
+            term.field = it.first;
+            term.slot = m_schema ? m_schema->slot(it.first) : -1;
+            term.op = it.second.first;
+            term.value = it.second.second;
+            m_terms.push_back(std::move(term));
+        }
+        m_statusSlot = m_schema ? m_schema->slot(STATUS) : -1;
+    }
 
-            std::string lhs = entry->getField(it.first);
-            std::string rhs = it.second.second;
+    bool empty() const { return m_terms.empty(); }
 
-            if (it.second.first == Condition::Op::eq)
+    bool matches(Entry& _entry)
+    {
+        if (m_terms.empty())
+        {
+            return true;
+        }
+        bool schema = _entry.schema() == m_schema;
+        auto status = schema && m_statusSlot >= 0 ? _entry.slotField(m_statusSlot) :
+                                                    _entry.findField(STATUS);
+        if (status && *status != "0" && _entry.getStatus() == Entry::Status::DELETED)
+        {
+            return false;
+        }
+
+        for (auto& term : m_terms)
+        {
+            auto value = schema && term.slot >= 0 ? _entry.slotField(term.slot) :
+                                                    _entry.findField(term.field);
+            const std::string& lhs = value ? *value : c_empty;
+            switch (term.op)
             {
-                if (lhs != rhs)
+            case Condition::Op::eq:
+                if (lhs != term.value)
                 {
                     return false;
                 }
-            }
-            else if (it.second.first == Condition::Op::ne)
-            {
-                if (lhs == rhs)
+                break;
+            case Condition::Op::ne:
+                if (lhs == term.value)
                 {
                     return false;
                 }
-            }
-            else
+                break;
+            default:
             {
-                if (lhs.empty())
+                Decimal lhsNum(lhs);
+                Decimal rhsNum(term.value);
+                if (!lhsNum.valid || !rhsNum.valid ||
+                    (!m_exact && (!lhsNum.isInt() || !rhsNum.isInt())))
                 {
-                    lhs = "0";
+                    ++m_invalid;
+                    return false;
                 }
-                if (rhs.empty())
+                int c = lhsNum.compare(rhsNum);
+                if ((term.op == Condition::Op::gt && c <= 0) ||
+                    (term.op == Condition::Op::ge && c < 0) ||
+                    (term.op == Condition::Op::lt && c >= 0) ||
+                    (term.op == Condition::Op::le && c > 0))
                 {
-                    rhs = "0";
+                    return false;
                 }
+                break;
+            }
+            }
+        }
+        return true;
+    }
 
-                int lhsNum = boost::lexical_cast<int>(lhs);
-                int rhsNum = boost::lexical_cast<int>(rhs);
+    /// the value of the first EQ condition on one of the fields, nullptr if there is none
+    std::pair<std::string, std::string> const* eqTerm(std::vector<std::string> const& _fields)
+    {
+        for (auto& term : m_terms)
+        {
+            if (term.op == Condition::Op::eq &&
+                std::find(_fields.begin(), _fields.end(), term.field) != _fields.end())
+            {
+                m_eq = std::make_pair(term.field, term.value);
+                return &m_eq;
+            }
+        }
+        return nullptr;
+    }
 
-                switch (it.second.first)
-                {
-                case Condition::Op::eq:
-                case Condition::Op::ne:
-                {
-                    break;
-                }
-                case Condition::Op::gt:
-                {
-                    if (lhsNum <= rhsNum)
-                    {
-                        return false;
-                    }
-                    break;
-                }
-                case Condition::Op::ge:
-                {
-                    if (lhsNum < rhsNum)
-                    {
-                        return false;
-                    }
-                    break;
-                }
-                case Condition::Op::lt:
-                {
-                    if (lhsNum >= rhsNum)
-                    {
-                        return false;
-                    }
-                    break;
-                }
-                case Condition::Op::le:
-                {
-                    if (lhsNum > rhsNum)
-                    {
-                        return false;
-                    }
-                    break;
-                }
-                }
+    /// rows not compared for a value that isn't a number
+    size_t invalid() const { return m_invalid; }
+
+private:
+    struct Term
+    {
+        std::string field;
+        int slot;
+        Condition::Op op;
+        std::string value;
+    };
+
+    static const std::string c_empty;
+    EntrySchema::Ptr m_schema;
+    bool m_exact;
+    std::vector<Term> m_terms;
+    int m_statusSlot = -1;
+    std::pair<std::string, std::string> m_eq;
+    size_t m_invalid = 0;
+};
+
+const std::string Predicate::c_empty;
+
+/// a key needs that many rows for an index to be built
+const size_t c_minIndexedRows = 32;
+}  // namespace
+
+std::vector<size_t> MemoryTable::processEntries(
+    const std::string& key, Entries::Ptr entries, Condition::Ptr condition, bool _limit)
+{
+    std::vector<size_t> indexes;
+    size_t offset = _limit ? condition->getOffset() : 0;
+    size_t count = _limit && condition->getCount() > 0 ? condition->getCount() : entries->size();
+    auto add = [&](size_t i) {
+        if (offset > 0)
+        {
+            --offset;
+            return true;
+        }
+        indexes.push_back(i);
+        return indexes.size() < count;
+    };
+
+    Predicate predicate(condition, m_schema, m_exactConditions);
+    if (predicate.empty())
+    {
+        indexes.reserve(std::min(count, entries->size()));
+        for (size_t i = 0; i < entries->size() && add(i); ++i)
+        {
+        }
+        return indexes;
+    }
+
+    std::vector<size_t> const* rows = nullptr;
+    auto eq = m_tableInfo ? predicate.eqTerm(m_tableInfo->indices) : nullptr;
+    if (eq)
+    {
+        rows = indexedRows(key, entries, eq->first, eq->second);
+    }
+    if (rows)
+    {
+        for (auto i : *rows)
+        {
+            if (predicate.matches(*entries->get(i)) && !add(i))
+            {
+                break;
             }
         }
     }
-    catch (std::exception& e)
+    else
+    {
+        for (size_t i = 0; i < entries->size(); ++i)
+        {
+            if (predicate.matches(*entries->get(i)) && !add(i))
+            {
+                break;
+            }
+        }
+    }
+
+    if (predicate.invalid() > 0)
     {
-        STORAGE_LOG(ERROR) << "Compare error:" << boost::diagnostic_information(e);
+        STORAGE_LOG(ERROR) << "Compare error: " << predicate.invalid()
+                           << " row(s) of key:" << key << " can't be compared as numbers";
+    }
+    return indexes;
+}
 
-        return false;
+std::vector<size_t> const* MemoryTable::indexedRows(const std::string& key, Entries::Ptr entries,
+    const std::string& field, const std::string& value)
+{
+    if (!m_schema || entries->size() < c_minIndexedRows)
+    {
+        return nullptr;
     }
 
-    return true;
+    auto& index = m_indexes[std::make_pair(key, field)];
+    if (index.entries != entries || index.size != entries->size() ||
+        index.version != m_schema->version() || index.changes != m_changes)
+    {
+        index.rows.clear();
+        for (size_t i = 0; i < entries->size(); ++i)
+        {
+            auto entry = entries->get(i);
+            // changes to the entry are counted by m_schema from now on
+            entry->setSchema(m_schema);
+            auto fieldValue = entry->findField(field);
+            index.rows[fieldValue ? *fieldValue : std::string()].push_back(i);
+        }
+        index.entries = entries;
+        index.size = entries->size();
+        index.version = m_schema->version();
+        index.changes = m_changes;
+    }
+
+    static const std::vector<size_t> c_noRows;
+    auto it = index.rows.find(value);
+    return it != index.rows.end() ? &it->second : &c_noRows;
 }
 
 void MemoryTable::setBlockHash(h256 blockHash)
@@ -444,20 +653,24 @@ bool MemoryTable::isHashField(const std::string& _key)
 void MemoryTable::setTableInfo(TableInfo::Ptr _tableInfo)
 {
     m_tableInfo = _tableInfo;
+    m_schema = std::make_shared<EntrySchema>(m_tableInfo->fields);
+}
+
+Entry::Ptr MemoryTable::newEntry()
+{
+    return std::make_shared<Entry>(m_schema);
 }
 
 inline void MemoryTable::checkFiled(Entry::Ptr entry)
 {
-    for (auto& it : *(entry->fields()))
-    {
+    entry->forEachField([this](const std::string& name, const std::string&) {
         if (m_tableInfo->fields.end() ==
-            find(m_tableInfo->fields.begin(), m_tableInfo->fields.end(), it.first))
+            find(m_tableInfo->fields.begin(), m_tableInfo->fields.end(), name))
         {
-            STORAGE_LOG(ERROR) << "table:" << m_tableInfo->name
-                               << " doesn't have field:" << it.first;
+            STORAGE_LOG(ERROR) << "table:" << m_tableInfo->name << " doesn't have field:" << name;
             throw std::invalid_argument("Invalid key.");
         }
-    }
+    });
 }
 
 inline bool MemoryTable::checkAuthority(Address const& _origin) const
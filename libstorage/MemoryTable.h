@@ -22,6 +22,7 @@
 
 #include "Storage.h"
 #include "Table.h"
+#include <set>
 
 namespace dev
 {
@@ -46,22 +47,61 @@ public:
     virtual h256 hash();
     virtual void clear();
     virtual std::map<std::string, Entries::Ptr>* data() override;
+    virtual TableInfo::Ptr tableInfo() override { return m_tableInfo; }
+    /// the entry lays its fields out by the schema of the table
+    virtual Entry::Ptr newEntry() override;
 
     void setStateStorage(Storage::Ptr amopDB);
     void setBlockHash(h256 blockHash);
     void setBlockNum(int blockNum);
     void setTableInfo(TableInfo::Ptr tableInfo);
+    /// compare numbers of any size and apply Condition::limit, chains created without
+    /// storage.exactConditions compare int only and select every matching row
+    void setExactConditions(bool _exactConditions) { m_exactConditions = _exactConditions; }
+    /// select hands out copies of the rows, so that the rows cached by a table which outlives
+    /// the call can't be changed in place
+    void setSelectCopies(bool _selectCopies) { m_selectCopies = _selectCopies; }
 
     bool checkAuthority(Address const& _origin) const override;
 
 private:
-    std::vector<size_t> processEntries(Entries::Ptr entries, Condition::Ptr condition);
-    bool processCondition(Entry::Ptr entry, Condition::Ptr condition);
+    /// the rows of a key by the value of a field
+    struct Index
+    {
+        Entries::Ptr entries;
+        size_t size = 0;
+        uint64_t version = 0;
+        uint64_t changes = 0;
+        std::map<std::string, std::vector<size_t> > rows;
+    };
+
+    /// the indexes of the rows matching the condition, at most the limit of the condition
+    /// if _limit is set
+    std::vector<size_t> processEntries(const std::string& key, Entries::Ptr entries,
+        Condition::Ptr condition, bool _limit = false);
+    /// the rows of the key whose field has the value, nullptr if the field has no index or the
+    /// key has too few rows for one
+    std::vector<size_t> const* indexedRows(const std::string& key, Entries::Ptr entries,
+        const std::string& field, const std::string& value);
     bool isHashField(const std::string& _key);
     void checkFiled(Entry::Ptr entry);
+    Entries::Ptr loadEntries(const std::string& key);
     Storage::Ptr m_remoteDB;
     TableInfo::Ptr m_tableInfo;
+    EntrySchema::Ptr m_schema;
     std::map<std::string, Entries::Ptr> m_cache;
+    /// keys of m_cache whose entries may be dirty, hash() walks only these, in key order
+    std::set<std::string> m_dirtyKeys;
+    /// data() handed the cache out, rows may have been added behind m_dirtyKeys
+    bool m_rescanDirtyKeys = false;
+    /// size of the data hashed last time, to reserve the buffer
+    size_t m_hashDataSize = 0;
+    /// (key, field) -> index, built on demand for the fields in TableInfo::indices
+    std::map<std::pair<std::string, std::string>, Index> m_indexes;
+    /// counts the changes to the rows of m_cache made through the table
+    uint64_t m_changes = 0;
+    bool m_exactConditions = false;
+    bool m_selectCopies = false;
     h256 m_blockHash;
     int m_blockNum = 0;
 };
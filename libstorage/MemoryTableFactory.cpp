@@ -22,12 +22,14 @@
 #include "CNSPrecompiled.h"
 #include "Common.h"
 #include "MemoryTable.h"
+#include "StorageException.h"
 #include "SystemConfigPrecompiled.h"
 #include "TablePrecompiled.h"
 #include <libblockverifier/ExecutiveContext.h>
 #include <libdevcore/easylog.h>
 #include <libdevcrypto/Hash.h>
 #include <boost/algorithm/string.hpp>
+#include <set>
 
 using namespace dev;
 using namespace dev::storage;
@@ -42,6 +44,7 @@ MemoryTableFactory::MemoryTableFactory() : m_blockHash(h256(0)), m_blockNum(0)
     m_sysTables.push_back(SYS_NUMBER_2_HASH);
     m_sysTables.push_back(SYS_TX_HASH_2_BLOCK);
     m_sysTables.push_back(SYS_HASH_2_BLOCK);
+    m_sysTables.push_back(SYS_BLOCK_2_NONCES);
     m_sysTables.push_back(SYS_CNS);
     m_sysTables.push_back(SYS_CONFIG);
 }
@@ -74,6 +77,11 @@ Table::Ptr MemoryTableFactory::openTable(const string& tableName, bool authority
         tableInfo->key = entry->getField("key_field");
         string valueFields = entry->getField("value_field");
         boost::split(tableInfo->fields, valueFields, boost::is_any_of(","));
+        auto indexFields = entry->findField("index_field");
+        if (indexFields && !indexFields->empty())
+        {
+            boost::split(tableInfo->indices, *indexFields, boost::is_any_of(","));
+        }
     }
     tableInfo->fields.emplace_back(STATUS);
     tableInfo->fields.emplace_back(tableInfo->key);
@@ -84,6 +92,8 @@ Table::Ptr MemoryTableFactory::openTable(const string& tableName, bool authority
     memoryTable->setStateStorage(m_stateStorage);
     memoryTable->setBlockHash(m_blockHash);
     memoryTable->setBlockNum(m_blockNum);
+    memoryTable->setExactConditions(m_exactConditions);
+    memoryTable->setSelectCopies(m_selectCopies);
 
     // authority flag
     if (authorityFlag)
@@ -120,7 +130,8 @@ Table::Ptr MemoryTableFactory::openTable(const string& tableName, bool authority
 }
 
 Table::Ptr MemoryTableFactory::createTable(const string& tableName, const string& keyField,
-    const std::string& valueField, bool authorigytFlag, Address const& _origin)
+    const std::string& valueField, bool authorigytFlag, Address const& _origin,
+    const std::string& indexField)
 {
     STORAGE_LOG(DEBUG) << "Create Table:" << m_blockHash << " num:" << m_blockNum
                        << " table:" << tableName;
@@ -139,6 +150,25 @@ Table::Ptr MemoryTableFactory::createTable(const string& tableName, const string
     tableEntry->setField("table_name", tableName);
     tableEntry->setField("key_field", keyField);
     tableEntry->setField("value_field", valueField);
+    if (!indexField.empty())
+    {
+        // only value fields can be indexed, the key is already one
+        vector<string> valueFields;
+        vector<string> indexFields;
+        boost::split(valueFields, valueField, boost::is_any_of(","));
+        boost::split(indexFields, indexField, boost::is_any_of(","));
+        for (auto const& field : indexFields)
+        {
+            if (find(valueFields.begin(), valueFields.end(), field) == valueFields.end())
+            {
+                STORAGE_LOG(ERROR) << "index field " << field << " isn't a value field of "
+                                   << tableName;
+                return nullptr;
+            }
+        }
+        // tables without indexes keep the old _sys_tables_ rows and hashes
+        tableEntry->setField("index_field", indexField);
+    }
     createTableCode =
         sysTable->insert(tableName, tableEntry, std::make_shared<AccessOptions>(_origin));
     if (createTableCode == -1)
@@ -159,6 +189,19 @@ void MemoryTableFactory::setBlockNum(int64_t blockNum)
     m_blockNum = blockNum;
 }
 
+void MemoryTableFactory::setSelectCopies(bool _selectCopies)
+{
+    m_selectCopies = _selectCopies;
+    for (auto& it : m_name2Table)
+    {
+        auto table = std::dynamic_pointer_cast<MemoryTable>(it.second);
+        if (table)
+        {
+            table->setSelectCopies(_selectCopies);
+        }
+    }
+}
+
 h256 MemoryTableFactory::hash()
 {
     bytes data;
@@ -173,8 +216,7 @@ h256 MemoryTableFactory::hash()
             continue;
         }
 
-        bytes tableHash = table->hash().asBytes();
-        data.insert(data.end(), tableHash.begin(), tableHash.end());
+        data.insert(data.end(), hash.begin(), hash.end());
     }
     if (data.empty())
     {
@@ -201,6 +243,11 @@ void MemoryTableFactory::rollback(size_t _savepoint)
             entries->removeEntry(change.value[0].index);
             if (entries->size() == 0u)
                 data->erase(change.key);
+            if (change.table->tableInfo()->name == SYS_TABLES)
+            {
+                // the table created by the insert doesn't exist anymore
+                m_name2Table.erase(change.key);
+            }
             break;
         }
         case Change::Update:
@@ -248,6 +295,7 @@ void MemoryTableFactory::commitDB(h256 const& _blockHash, int64_t _blockNumber)
 
         dev::storage::TableData::Ptr tableData = make_shared<dev::storage::TableData>();
         tableData->tableName = dbIt.first;
+        tableData->info = table->tableInfo();
 
         bool dirtyTable = false;
         for (auto it : *(table->data()))
@@ -281,6 +329,99 @@ void MemoryTableFactory::commitDB(h256 const& _blockHash, int64_t _blockNumber)
     m_changeLog.clear();
 }
 
+namespace
+{
+bool isDirty(Entries::Ptr entries)
+{
+    if (entries->dirty())
+    {
+        return true;
+    }
+    for (size_t i = 0; i < entries->size(); ++i)
+    {
+        if (entries->get(i)->dirty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+bool MemoryTableFactory::conflicts(MemoryTableFactory& _other)
+{
+    for (auto& otherIt : _other.m_name2Table)
+    {
+        auto it = m_name2Table.find(otherIt.first);
+        if (it == m_name2Table.end())
+        {
+            continue;
+        }
+        if (it->second->tableInfo()->authorizedAddress !=
+            otherIt.second->tableInfo()->authorizedAddress)
+        {
+            return true;
+        }
+        auto data = it->second->data();
+        for (auto& row : *(otherIt.second->data()))
+        {
+            auto rowIt = data->find(row.first);
+            if (rowIt != data->end() && isDirty(rowIt->second))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void MemoryTableFactory::merge(MemoryTableFactory& _other)
+{
+    // tables created by _other are registered in _sys_tables_, it goes first so
+    // that they can be opened here
+    vector<pair<string, Table::Ptr>> tables;
+    for (auto& otherIt : _other.m_name2Table)
+    {
+        if (otherIt.first == SYS_TABLES)
+        {
+            tables.insert(tables.begin(), otherIt);
+        }
+        else
+        {
+            tables.push_back(otherIt);
+        }
+    }
+    set<string> opened;
+    for (auto& it : m_name2Table)
+    {
+        opened.insert(it.first);
+    }
+
+    for (auto& otherIt : tables)
+    {
+        auto table = openTable(otherIt.first);
+        if (!table)
+        {
+            BOOST_THROW_EXCEPTION(
+                StorageException(-1, "Merge can't open table: " + otherIt.first));
+        }
+        if (!opened.count(otherIt.first))
+        {
+            // serially the table would have been opened by the transactions of _other
+            table->tableInfo()->authorizedAddress = otherIt.second->tableInfo()->authorizedAddress;
+        }
+
+        auto data = table->data();
+        for (auto& row : *(otherIt.second->data()))
+        {
+            if (isDirty(row.second) || data->find(row.first) == data->end())
+            {
+                (*data)[row.first] = row.second;
+            }
+        }
+    }
+}
+
 storage::TableInfo::Ptr MemoryTableFactory::getSysTableInfo(const std::string& tableName)
 {
     auto tableInfo = make_shared<storage::TableInfo>();
@@ -289,16 +430,18 @@ storage::TableInfo::Ptr MemoryTableFactory::getSysTableInfo(const std::string& t
     {
         tableInfo->key = "name";
         tableInfo->fields = vector<string>{"type", "node_id", "enable_num"};
+        tableInfo->indices = vector<string>{"node_id"};
     }
     else if (tableName == SYS_TABLES)
     {
         tableInfo->key = "table_name";
-        tableInfo->fields = vector<string>{"key_field", "value_field"};
+        tableInfo->fields = vector<string>{"key_field", "value_field", "index_field"};
     }
     else if (tableName == SYS_ACCESS_TABLE)
     {
         tableInfo->key = "table_name";
         tableInfo->fields = vector<string>{"address", "enable_num"};
+        tableInfo->indices = vector<string>{"address"};
     }
     else if (tableName == SYS_CURRENT_STATE)
     {
@@ -320,6 +463,11 @@ storage::TableInfo::Ptr MemoryTableFactory::getSysTableInfo(const std::string& t
         tableInfo->key = "key";
         tableInfo->fields = std::vector<std::string>{"value"};
     }
+    else if (tableName == SYS_BLOCK_2_NONCES)
+    {
+        tableInfo->key = "number";
+        tableInfo->fields = std::vector<std::string>{"value"};
+    }
     else if (tableName == SYS_CNS)
     {
         tableInfo->key = dev::SYS_CNS_FIELD_NAME;
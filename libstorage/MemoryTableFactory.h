@@ -40,14 +40,20 @@ public:
 
     Table::Ptr openTable(const std::string& table, bool authorityFlag = true) override;
     Table::Ptr createTable(const std::string& tableName, const std::string& keyField,
-        const std::string& valueField, bool authorigytFlag,
-        Address const& _origin = Address()) override;
+        const std::string& valueField, bool authorigytFlag, Address const& _origin = Address(),
+        const std::string& indexField = "") override;
 
     virtual Storage::Ptr stateStorage() { return m_stateStorage; }
     virtual void setStateStorage(Storage::Ptr stateStorage) { m_stateStorage = stateStorage; }
 
     void setBlockHash(h256 blockHash);
     void setBlockNum(int64_t blockNum);
+    h256 blockHash() const { return m_blockHash; }
+    int64_t blockNum() const { return m_blockNum; }
+    /// see MemoryTable::setExactConditions, applies to the tables opened from now on
+    void setExactConditions(bool _exactConditions) { m_exactConditions = _exactConditions; }
+    /// see MemoryTable::setSelectCopies, applies to the opened tables too
+    void setSelectCopies(bool _selectCopies);
 
     h256 hash();
     size_t savepoint() const { return m_changeLog.size(); };
@@ -55,6 +61,13 @@ public:
     void commit();
     void commitDB(h256 const& _blockHash, int64_t _blockNumber);
 
+    /// true if a row _other has read or written is dirty in this factory, or a
+    /// table opened by both has different authorized addresses
+    bool conflicts(MemoryTableFactory& _other);
+    /// take over the rows of _other as if its transactions had executed on this
+    /// factory, only valid when conflicts(_other) is false
+    void merge(MemoryTableFactory& _other);
+
     int getCreateTableCode() { return createTableCode; }
 
 private:
@@ -63,6 +76,8 @@ private:
     Storage::Ptr m_stateStorage;
     h256 m_blockHash;
     int m_blockNum;
+    bool m_exactConditions = false;
+    bool m_selectCopies = false;
     std::map<std::string, Table::Ptr> m_name2Table;
     std::vector<Change> m_changeLog;
     h256 m_hash;
@@ -0,0 +1,71 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/** @file Storage.cpp
+ *  @author agent
+ *  @date 20261018
+ */
+
+#include "Storage.h"
+
+using namespace dev;
+using namespace dev::storage;
+
+std::vector<Entries::Ptr> Storage::batchSelect(
+    h256 hash, int num, std::vector<TableKey> const& keys)
+{
+    std::vector<Entries::Ptr> result;
+    result.reserve(keys.size());
+    for (auto const& tableKey : keys)
+    {
+        result.push_back(select(hash, num, tableKey.table, tableKey.key));
+    }
+    return result;
+}
+
+Entries::Ptr dev::storage::copyEntries(Entries::Ptr entries)
+{
+    Entries::Ptr copy = std::make_shared<Entries>();
+    for (size_t i = 0; i < entries->size(); ++i)
+    {
+        auto entry = entries->get(i);
+        Entry::Ptr entryCopy = std::make_shared<Entry>(*entry);
+        copy->addEntry(entryCopy);
+    }
+    copy->setDirty(entries->dirty());
+    return copy;
+}
+
+Entries::Ptr dev::storage::committedEntries(Entries::Ptr entries, h256 const& hash, int64_t num)
+{
+    auto hashStr = hash.hex();
+    auto numStr = std::to_string(num);
+    Entries::Ptr committed = std::make_shared<Entries>();
+    for (size_t i = 0; i < entries->size(); ++i)
+    {
+        auto entry = entries->get(i);
+        if (entry->getStatus() != Entry::Status::NORMAL)
+        {
+            continue;
+        }
+        Entry::Ptr copy = std::make_shared<Entry>(*entry);
+        copy->setField("_hash_", hashStr);
+        copy->setField("_num_", numStr);
+        copy->setDirty(false);
+        committed->addEntry(copy);
+    }
+    return committed;
+}
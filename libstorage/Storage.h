@@ -21,6 +21,7 @@
 #pragma once
 
 #include "Table.h"
+#include <functional>
 
 namespace dev
 {
@@ -32,9 +33,17 @@ public:
     typedef std::shared_ptr<TableData> Ptr;
 
     std::string tableName;
+    TableInfo::Ptr info;
     std::map<std::string, Entries::Ptr> data;
 };
 
+/// a key of a table, for the batch selects
+struct TableKey
+{
+    std::string table;
+    std::string key;
+};
+
 class Storage : public std::enable_shared_from_this<Storage>
 {
 public:
@@ -44,11 +53,27 @@ public:
 
     virtual Entries::Ptr select(
         h256 hash, int num, const std::string& table, const std::string& key) = 0;
+    /// the rows of every key, in the order of keys, the backends override it to read the keys
+    /// together instead of one select per key
+    virtual std::vector<Entries::Ptr> batchSelect(
+        h256 hash, int num, std::vector<TableKey> const& keys);
+    /// load the rows of the keys into the cache of the storage, nothing if it has no cache
+    virtual void prefetch(h256, int, std::vector<TableKey> const&) {}
     virtual size_t commit(
         h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash) = 0;
     virtual bool onlyDirty() = 0;
+    /// the oldest block whose commit hasn't reached the persistent backend, -1 if none
+    virtual int64_t pendingNumber() { return -1; }
+    /// _handler(num) is called when block num reached the persistent backend after its commit
+    /// returned, nothing if every commit is persisted before it returns
+    virtual void setPersistHandler(std::function<void(int64_t)>) {}
 };
 
+/// deep copy of entries, MemoryTable modifies the entries it selects in place
+Entries::Ptr copyEntries(Entries::Ptr entries);
+/// the rows a backend returns for entries once they are committed at (hash, num)
+Entries::Ptr committedEntries(Entries::Ptr entries, h256 const& hash, int64_t num);
+
 }  // namespace storage
 
 }  // namespace dev
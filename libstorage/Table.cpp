@@ -31,23 +31,64 @@
 #include "Table.h"
 #include <libdevcore/easylog.h>
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <map>
 
 using namespace dev::storage;
 
+namespace
+{
+typedef std::pair<std::string, std::string> Field;
+
+bool fieldLess(Field const& field, const std::string& key)
+{
+    return field.first < key;
+}
+}  // namespace
+
+EntrySchema::EntrySchema(std::vector<std::string> const& fields) : m_fields(fields)
+{
+    std::sort(m_fields.begin(), m_fields.end());
+    m_fields.erase(std::unique(m_fields.begin(), m_fields.end()), m_fields.end());
+    if (m_fields.size() > c_maxSlots)
+    {
+        m_fields.resize(c_maxSlots);
+    }
+}
+
+int EntrySchema::slot(const std::string& field) const
+{
+    auto it = std::lower_bound(m_fields.begin(), m_fields.end(), field);
+    if (it == m_fields.end() || *it != field)
+    {
+        return -1;
+    }
+    return it - m_fields.begin();
+}
+
 Entry::Entry()
 {
     // status required
-    m_fields.insert(std::make_pair(STATUS, "0"));
+    storeField(STATUS, "0");
+}
+
+Entry::Entry(EntrySchema::Ptr schema) : m_schema(schema)
+{
+    if (m_schema)
+    {
+        m_values.resize(m_schema->size());
+    }
+    // status required
+    storeField(STATUS, "0");
 }
 
 std::string Entry::getField(const std::string& key) const
 {
-    auto it = m_fields.find(key);
+    auto value = findField(key);
 
-    if (it != m_fields.end())
+    if (value)
     {
-        return it->second;
+        return *value;
     }
 
     STORAGE_LOG(ERROR) << "Entry: " << this << " can't find key: " + key;
@@ -57,49 +98,94 @@ std::string Entry::getField(const std::string& key) const
 
 void Entry::setField(const std::string& key, const std::string& value)
 {
-    auto it = m_fields.find(key);
+    storeField(key, value);
+
+    m_dirty = true;
+}
 
-    if (it != m_fields.end())
+const std::string* Entry::findField(const std::string& key) const
+{
+    int slot = m_schema ? m_schema->slot(key) : -1;
+    if (slot >= 0)
     {
-        it->second = value;
+        return slotField(slot);
     }
-    else
+    auto it = std::lower_bound(m_extra.begin(), m_extra.end(), key, fieldLess);
+    if (it != m_extra.end() && it->first == key)
     {
-        m_fields.insert(std::make_pair(key, value));
+        return &it->second;
     }
-
-    m_dirty = true;
+    return nullptr;
 }
 
-std::map<std::string, std::string>* Entry::fields()
+void Entry::storeField(const std::string& key, std::string value)
 {
-    return &m_fields;
+    if (m_schema)
+    {
+        m_schema->touch();
+    }
+    int slot = m_schema ? m_schema->slot(key) : -1;
+    if (slot >= 0)
+    {
+        m_values[slot] = std::move(value);
+        m_present |= uint64_t(1) << slot;
+        return;
+    }
+    auto it = std::lower_bound(m_extra.begin(), m_extra.end(), key, fieldLess);
+    if (it != m_extra.end() && it->first == key)
+    {
+        it->second = std::move(value);
+    }
+    else
+    {
+        m_extra.emplace(it, key, std::move(value));
+    }
 }
 
-uint32_t Entry::getStatus()
+void Entry::setSchema(EntrySchema::Ptr schema)
 {
-    auto it = m_fields.find(STATUS);
-    if (it == m_fields.end())
+    if (schema == m_schema)
     {
-        return 0;
+        return;
     }
-    else
+    if (schema && m_schema && schema->fields() == m_schema->fields())
     {
-        return boost::lexical_cast<uint32_t>(it->second);
+        // the same layout, the changes are counted by the new schema from now on
+        m_schema = schema;
+        return;
+    }
+    std::vector<Field> fields;
+    fields.reserve(m_values.size() + m_extra.size());
+    forEachField([&fields](const std::string& name, const std::string& value) {
+        fields.emplace_back(name, value);
+    });
+
+    m_schema = schema;
+    m_values.assign(m_schema ? m_schema->size() : 0, std::string());
+    m_present = 0;
+    m_extra.clear();
+    for (auto& field : fields)
+    {
+        storeField(field.first, std::move(field.second));
     }
 }
 
-void Entry::setStatus(int status)
+uint32_t Entry::getStatus()
 {
-    auto it = m_fields.find(STATUS);
-    if (it == m_fields.end())
+    auto value = findField(STATUS);
+    if (!value)
     {
-        m_fields.insert(std::make_pair(STATUS, boost::lexical_cast<std::string>(status)));
+        return 0;
     }
     else
     {
-        it->second = boost::lexical_cast<std::string>(status);
+        return boost::lexical_cast<uint32_t>(*value);
     }
+}
+
+void Entry::setStatus(int status)
+{
+    storeField(STATUS, boost::lexical_cast<std::string>(status));
 
     m_dirty = true;
 }
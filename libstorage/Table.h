@@ -20,6 +20,7 @@
 #include "Common.h"
 #include <libdevcore/Address.h>
 #include <libdevcore/FixedHash.h>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <vector>
@@ -36,6 +37,8 @@ struct TableInfo : public std::enable_shared_from_this<TableInfo>
     std::string key;
     std::vector<std::string> fields;
     std::vector<Address> authorizedAddress;
+    /// fields with an in-memory index for the EQ conditions of selects
+    std::vector<std::string> indices;
 };
 
 struct AccessOptions : public std::enable_shared_from_this<AccessOptions>
@@ -46,6 +49,34 @@ struct AccessOptions : public std::enable_shared_from_this<AccessOptions>
     Address origin;
 };
 
+/// the fields of a table, sorted by name, a field's position is the slot of its value in the
+/// entries of the table
+class EntrySchema
+{
+public:
+    typedef std::shared_ptr<EntrySchema> Ptr;
+
+    /// the presence of the slots is a bit mask, further fields are kept like unknown ones
+    static const size_t c_maxSlots = 64;
+
+    explicit EntrySchema(std::vector<std::string> const& fields);
+
+    /// -1 if the field has no slot
+    int slot(const std::string& field) const;
+    size_t size() const { return m_fields.size(); }
+    std::string const& field(size_t slot) const { return m_fields[slot]; }
+    std::vector<std::string> const& fields() const { return m_fields; }
+
+    /// counts the changes to the entries of the schema, to find out of date indexes, entries
+    /// sharing a schema can be changed from several threads
+    uint64_t version() const { return m_version; }
+    void touch() { ++m_version; }
+
+private:
+    std::vector<std::string> m_fields;
+    std::atomic<uint64_t> m_version{0};
+};
+
 class Entry : public std::enable_shared_from_this<Entry>
 {
 public:
@@ -58,11 +89,25 @@ public:
     };
 
     Entry();
+    explicit Entry(EntrySchema::Ptr schema);
     virtual ~Entry() {}
 
     virtual std::string getField(const std::string& key) const;
     virtual void setField(const std::string& key, const std::string& value);
-    virtual std::map<std::string, std::string>* fields();
+    /// nullptr if the entry doesn't have the field
+    const std::string* findField(const std::string& key) const;
+    /// the value in a slot of the schema, nullptr if the entry doesn't have it
+    const std::string* slotField(size_t slot) const
+    {
+        return (m_present & (uint64_t(1) << slot)) ? &m_values[slot] : nullptr;
+    }
+    /// calls _f(name, value) for every field, in the order of the names
+    template <typename F>
+    void forEachField(F _f) const;
+
+    /// moves the fields into the slots of the schema, the entry isn't marked dirty
+    void setSchema(EntrySchema::Ptr schema);
+    EntrySchema::Ptr schema() const { return m_schema; }
 
     virtual uint32_t getStatus();
     virtual void setStatus(int status);
@@ -71,10 +116,41 @@ public:
     void setDirty(bool dirty);
 
 private:
-    std::map<std::string, std::string> m_fields;
+    void storeField(const std::string& key, std::string value);
+
+    EntrySchema::Ptr m_schema;
+    /// one per slot of the schema, small values are stored inline by std::string
+    std::vector<std::string> m_values;
+    uint64_t m_present = 0;
+    /// the fields without a slot, sorted by name
+    std::vector<std::pair<std::string, std::string> > m_extra;
     bool m_dirty = false;
 };
 
+template <typename F>
+void Entry::forEachField(F _f) const
+{
+    // both the slots and the extra fields are sorted by name
+    auto extra = m_extra.begin();
+    for (size_t i = 0; i < m_values.size(); ++i)
+    {
+        if (!(m_present & (uint64_t(1) << i)))
+        {
+            continue;
+        }
+        auto const& name = m_schema->field(i);
+        for (; extra != m_extra.end() && extra->first < name; ++extra)
+        {
+            _f(extra->first, extra->second);
+        }
+        _f(name, m_values[i]);
+    }
+    for (; extra != m_extra.end(); ++extra)
+    {
+        _f(extra->first, extra->second);
+    }
+}
+
 class Entries : public std::enable_shared_from_this<Entries>
 {
 public:
@@ -127,6 +203,9 @@ public:
     virtual void limit(size_t offset, size_t count);
 
     virtual std::map<std::string, std::pair<Op, std::string> >* getConditions();
+    size_t getOffset() const { return m_offset; }
+    /// 0 if there is no limit
+    size_t getCount() const { return m_count; }
 
 private:
     std::map<std::string, std::pair<Op, std::string> > m_conditions;
@@ -193,6 +272,7 @@ public:
     virtual h256 hash() = 0;
     virtual void clear() = 0;
     virtual std::map<std::string, Entries::Ptr>* data() { return NULL; }
+    virtual TableInfo::Ptr tableInfo() { return nullptr; }
     virtual bool checkAuthority(Address const& _origin) const = 0;
 
 protected:
@@ -210,7 +290,8 @@ public:
 
     virtual Table::Ptr openTable(const std::string& table, bool authorityFlag = true) = 0;
     virtual Table::Ptr createTable(const std::string& tableName, const std::string& keyField,
-        const std::string& valueField, bool authorigytFlag, Address const& _origin = Address()) = 0;
+        const std::string& valueField, bool authorigytFlag, Address const& _origin = Address(),
+        const std::string& indexField = "") = 0;
 };
 
 }  // namespace storage
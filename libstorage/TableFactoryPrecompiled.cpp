@@ -36,11 +36,25 @@ using namespace dev::storage;
 
 const char* const TABLE_METHOD_OPT_STR = "openTable(string)";
 const char* const TABLE_METHOD_CRT_STR_STR = "createTable(string,string,string)";
+const char* const TABLE_METHOD_CRT_STR_STR_STR = "createTable(string,string,string,string)";
+
+namespace
+{
+string trimFields(string const& _fields)
+{
+    vector<string> fieldNameList;
+    boost::split(fieldNameList, _fields, boost::is_any_of(","));
+    for (auto& str : fieldNameList)
+        boost::trim(str);
+    return boost::join(fieldNameList, ",");
+}
+}  // namespace
 
 TableFactoryPrecompiled::TableFactoryPrecompiled()
 {
     name2Selector[TABLE_METHOD_OPT_STR] = getFuncSelector(TABLE_METHOD_OPT_STR);
     name2Selector[TABLE_METHOD_CRT_STR_STR] = getFuncSelector(TABLE_METHOD_CRT_STR_STR);
+    name2Selector[TABLE_METHOD_CRT_STR_STR_STR] = getFuncSelector(TABLE_METHOD_CRT_STR_STR_STR);
 }
 
 std::string TableFactoryPrecompiled::toString(std::shared_ptr<ExecutiveContext>)
@@ -75,7 +89,7 @@ bytes TableFactoryPrecompiled::call(
         {
             TablePrecompiled::Ptr tablePrecompiled = make_shared<TablePrecompiled>();
             tablePrecompiled->setTable(table);
-            address = context->registerPrecompiled(tablePrecompiled);
+            address = context->registerTransientPrecompiled(tablePrecompiled);
         }
         else
         {
@@ -91,11 +105,7 @@ bytes TableFactoryPrecompiled::call(
         string valueFiled;
 
         abi.abiOut(data, tableName, keyField, valueFiled);
-        vector<string> fieldNameList;
-        boost::split(fieldNameList, valueFiled, boost::is_any_of(","));
-        for (auto& str : fieldNameList)
-            boost::trim(str);
-        valueFiled = boost::join(fieldNameList, ",");
+        valueFiled = trimFields(valueFiled);
         tableName = storage::USER_TABLE_PREFIX + tableName;
         auto table =
             m_memoryTableFactory->createTable(tableName, keyField, valueFiled, true, origin);
@@ -103,6 +113,23 @@ bytes TableFactoryPrecompiled::call(
         int errorCode = m_memoryTableFactory->getCreateTableCode();
         out = abi.abiIn("", u256(errorCode));
     }
+    else if (func == name2Selector[TABLE_METHOD_CRT_STR_STR_STR])
+    {  // createTable(string,string,string,string)
+        string tableName;
+        string keyField;
+        string valueFiled;
+        string indexField;
+
+        abi.abiOut(data, tableName, keyField, valueFiled, indexField);
+        valueFiled = trimFields(valueFiled);
+        indexField = trimFields(indexField);
+        tableName = storage::USER_TABLE_PREFIX + tableName;
+        auto table = m_memoryTableFactory->createTable(
+            tableName, keyField, valueFiled, true, origin, indexField);
+        // set createTableCode
+        int errorCode = m_memoryTableFactory->getCreateTableCode();
+        out = abi.abiIn("", u256(errorCode));
+    }
     return out;
 }
 
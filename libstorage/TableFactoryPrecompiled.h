@@ -32,6 +32,7 @@ namespace blockverifier
 {
 #if 0
 {
+    "0a531dfd": "createTable(string,string,string,string)",
     "56004b6a": "createTable(string,string,string)",
     "c184e0ff": "openDB(string)",
     "f23f63c9": "openTable(string)"
@@ -40,6 +41,7 @@ contract DBFactory {
     function openDB(string) public constant returns (DB);
     function openTable(string) public constant returns (DB);
     function createTable(string, string, string) public constant returns (int);
+    function createTable(string, string, string, string) public constant returns (int);
 }
 #endif
 
@@ -38,15 +38,13 @@ const char* const TABLE_METHOD_RE_STR_ADD = "remove(string,address)";
 const char* const TABLE_METHOD_UP_STR_2ADD = "update(string,address,address)";
 
 
-TablePrecompiled::TablePrecompiled()
-{
-    name2Selector[TABLE_METHOD_SLT_STR_ADD] = getFuncSelector(TABLE_METHOD_SLT_STR_ADD);
-    name2Selector[TABLE_METHOD_INS_STR_ADD] = getFuncSelector(TABLE_METHOD_INS_STR_ADD);
-    name2Selector[TABLE_METHOD_NEWCOND] = getFuncSelector(TABLE_METHOD_NEWCOND);
-    name2Selector[TABLE_METHOD_NEWENT] = getFuncSelector(TABLE_METHOD_NEWENT);
-    name2Selector[TABLE_METHOD_RE_STR_ADD] = getFuncSelector(TABLE_METHOD_RE_STR_ADD);
-    name2Selector[TABLE_METHOD_UP_STR_2ADD] = getFuncSelector(TABLE_METHOD_UP_STR_2ADD);
-}
+/// the selectors are the same for every instance, computed once
+const uint32_t TABLE_METHOD_SLT_STR_ADD_SELECTOR = getFuncSelector(TABLE_METHOD_SLT_STR_ADD);
+const uint32_t TABLE_METHOD_INS_STR_ADD_SELECTOR = getFuncSelector(TABLE_METHOD_INS_STR_ADD);
+const uint32_t TABLE_METHOD_NEWCOND_SELECTOR = getFuncSelector(TABLE_METHOD_NEWCOND);
+const uint32_t TABLE_METHOD_NEWENT_SELECTOR = getFuncSelector(TABLE_METHOD_NEWENT);
+const uint32_t TABLE_METHOD_RE_STR_ADD_SELECTOR = getFuncSelector(TABLE_METHOD_RE_STR_ADD);
+const uint32_t TABLE_METHOD_UP_STR_2ADD_SELECTOR = getFuncSelector(TABLE_METHOD_UP_STR_2ADD);
 
 std::string TablePrecompiled::toString(std::shared_ptr<ExecutiveContext>)
 {
@@ -67,7 +65,7 @@ bytes TablePrecompiled::call(
 
     bytes out;
 
-    if (func == name2Selector[TABLE_METHOD_SLT_STR_ADD])
+    if (func == TABLE_METHOD_SLT_STR_ADD_SELECTOR)
     {  // select(string,address)
         std::string key;
         Address conditionAddress;
@@ -76,16 +74,21 @@ bytes TablePrecompiled::call(
         ConditionPrecompiled::Ptr conditionPrecompiled =
             std::dynamic_pointer_cast<ConditionPrecompiled>(
                 context->getPrecompiled(conditionAddress));
+        if (!conditionPrecompiled)
+        {
+            STORAGE_LOG(ERROR) << "select with invalid condition: " << conditionAddress;
+            return abi.abiIn("", Address());
+        }
         auto condition = conditionPrecompiled->getCondition();
 
         auto entries = m_table->select(key, condition);
         auto entriesPrecompiled = std::make_shared<EntriesPrecompiled>();
         entriesPrecompiled->setEntries(entries);
 
-        auto newAddress = context->registerPrecompiled(entriesPrecompiled);
+        auto newAddress = context->registerTransientPrecompiled(entriesPrecompiled);
         out = abi.abiIn("", newAddress);
     }
-    else if (func == name2Selector[TABLE_METHOD_INS_STR_ADD])
+    else if (func == TABLE_METHOD_INS_STR_ADD_SELECTOR)
     {  // insert(string,address)
         std::string key;
         Address entryAddress;
@@ -93,30 +96,35 @@ bytes TablePrecompiled::call(
 
         EntryPrecompiled::Ptr entryPrecompiled =
             std::dynamic_pointer_cast<EntryPrecompiled>(context->getPrecompiled(entryAddress));
+        if (!entryPrecompiled)
+        {
+            STORAGE_LOG(ERROR) << "insert with invalid entry: " << entryAddress;
+            return abi.abiIn("", u256(-1));
+        }
         auto entry = entryPrecompiled->getEntry();
 
         int count = m_table->insert(key, entry, getOptions(origin));
         out = abi.abiIn("", u256(count));
     }
-    else if (func == name2Selector[TABLE_METHOD_NEWCOND])
+    else if (func == TABLE_METHOD_NEWCOND_SELECTOR)
     {  // newCondition()
         auto condition = m_table->newCondition();
         auto conditionPrecompiled = std::make_shared<ConditionPrecompiled>();
         conditionPrecompiled->setCondition(condition);
 
-        auto newAddress = context->registerPrecompiled(conditionPrecompiled);
+        auto newAddress = context->registerTransientPrecompiled(conditionPrecompiled);
         out = abi.abiIn("", newAddress);
     }
-    else if (func == name2Selector[TABLE_METHOD_NEWENT])
+    else if (func == TABLE_METHOD_NEWENT_SELECTOR)
     {  // newEntry()
         auto entry = m_table->newEntry();
         auto entryPrecompiled = std::make_shared<EntryPrecompiled>();
         entryPrecompiled->setEntry(entry);
 
-        auto newAddress = context->registerPrecompiled(entryPrecompiled);
+        auto newAddress = context->registerTransientPrecompiled(entryPrecompiled);
         out = abi.abiIn("", newAddress);
     }
-    else if (func == name2Selector[TABLE_METHOD_RE_STR_ADD])
+    else if (func == TABLE_METHOD_RE_STR_ADD_SELECTOR)
     {  // remove(string,address)
         std::string key;
         Address conditionAddress;
@@ -125,12 +133,17 @@ bytes TablePrecompiled::call(
         ConditionPrecompiled::Ptr conditionPrecompiled =
             std::dynamic_pointer_cast<ConditionPrecompiled>(
                 context->getPrecompiled(conditionAddress));
+        if (!conditionPrecompiled)
+        {
+            STORAGE_LOG(ERROR) << "remove with invalid condition: " << conditionAddress;
+            return abi.abiIn("", u256(-1));
+        }
         auto condition = conditionPrecompiled->getCondition();
 
         int count = m_table->remove(key, condition, getOptions(origin));
         out = abi.abiIn("", u256(count));
     }
-    else if (func == name2Selector[TABLE_METHOD_UP_STR_2ADD])
+    else if (func == TABLE_METHOD_UP_STR_2ADD_SELECTOR)
     {  // update(string,address,address)
         std::string key;
         Address entryAddress;
@@ -142,6 +155,12 @@ bytes TablePrecompiled::call(
         ConditionPrecompiled::Ptr conditionPrecompiled =
             std::dynamic_pointer_cast<ConditionPrecompiled>(
                 context->getPrecompiled(conditionAddress));
+        if (!entryPrecompiled || !conditionPrecompiled)
+        {
+            STORAGE_LOG(ERROR) << "update with invalid entry: " << entryAddress
+                               << " or condition: " << conditionAddress;
+            return abi.abiIn("", u256(-1));
+        }
         auto entry = entryPrecompiled->getEntry();
         auto condition = conditionPrecompiled->getCondition();
 
@@ -26,6 +26,7 @@
 #include "libdevcrypto/Hash.h"
 #include "libethcore/Exceptions.h"
 #include "libstorage/MemoryTableFactory.h"
+#include <iterator>
 
 using namespace dev;
 using namespace dev::eth;
@@ -33,6 +34,42 @@ using namespace dev::storagestate;
 using namespace dev::storage;
 using namespace dev::executive;
 
+namespace
+{
+/// Binary storage slots: the key is the 32 big endian bytes of the slot, so that it never
+/// equals the name of an account row, the value is big endian without the leading zero bytes.
+/// The slots of chains created without state.binaryStorage are decimal strings.
+std::string slotKey(u256 const& _key)
+{
+    std::string key;
+    key.reserve(32);
+    boost::multiprecision::export_bits(_key, std::back_inserter(key), 8);
+    key.insert(0, 32 - key.size(), '\0');
+    return key;
+}
+
+std::string slotValue(u256 const& _value)
+{
+    std::string value;
+    if (_value)
+    {
+        boost::multiprecision::export_bits(_value, std::back_inserter(value), 8);
+    }
+    return value;
+}
+
+u256 slotValue(std::string const& _value)
+{
+    u256 value;
+    if (!_value.empty())
+    {
+        auto begin = reinterpret_cast<uint8_t const*>(_value.data());
+        boost::multiprecision::import_bits(value, begin, begin + _value.size(), 8);
+    }
+    return value;
+}
+}  // namespace
+
 bool StorageState::addressInUse(Address const& _address) const
 {
     auto table = getTable(_address);
@@ -173,10 +210,12 @@ u256 StorageState::storage(Address const& _address, u256 const& _key) const
     auto table = getTable(_address);
     if (table)
     {
-        auto entries = table->select(_key.str(), table->newCondition());
+        auto entries =
+            table->select(m_binaryStorage ? slotKey(_key) : _key.str(), table->newCondition());
         if (entries->size() != 0u)
         {
-            return u256(entries->get(0)->getField(STORAGE_VALUE));
+            auto const& value = entries->get(0)->getField(STORAGE_VALUE);
+            return m_binaryStorage ? slotValue(value) : u256(value);
         }
     }
     return u256();
@@ -187,20 +226,18 @@ void StorageState::setStorage(Address const& _address, u256 const& _location, u2
     auto table = getTable(_address);
     if (table)
     {
-        auto entries = table->select(_location.str(), table->newCondition());
+        auto key = m_binaryStorage ? slotKey(_location) : _location.str();
+        auto entry = table->newEntry();
+        entry->setField(STORAGE_KEY, key);
+        entry->setField(STORAGE_VALUE, m_binaryStorage ? slotValue(_value) : _value.str());
+        auto entries = table->select(key, table->newCondition());
         if (entries->size() == 0u)
         {
-            auto entry = table->newEntry();
-            entry->setField(STORAGE_KEY, _location.str());
-            entry->setField(STORAGE_VALUE, _value.str());
-            table->insert(_location.str(), entry);
+            table->insert(key, entry);
         }
         else
         {
-            auto entry = table->newEntry();
-            entry->setField(STORAGE_KEY, _location.str());
-            entry->setField(STORAGE_VALUE, _value.str());
-            table->update(_location.str(), entry, table->newCondition());
+            table->update(key, entry, table->newCondition());
         }
     }
 }
@@ -400,6 +437,31 @@ bool StorageState::checkAuthority(Address const& _origin, Address const& _contra
         return true;
 }
 
+void StorageState::prefetch(std::vector<Address> const& _addresses)
+{
+    auto stateStorage = m_memoryTableFactory->stateStorage();
+    if (!stateStorage)
+    {
+        return;
+    }
+    std::vector<storage::TableKey> keys;
+    keys.reserve(_addresses.size() * 7);
+    for (auto const& address : _addresses)
+    {
+        std::string tableName("_contract_data_" + address.hex() + "_");
+        // read by openTable
+        keys.push_back(storage::TableKey{storage::SYS_TABLES, tableName});
+        keys.push_back(storage::TableKey{storage::SYS_ACCESS_TABLE, tableName});
+        for (auto key :
+            {ACCOUNT_BALANCE, ACCOUNT_CODE_HASH, ACCOUNT_CODE, ACCOUNT_NONCE, ACCOUNT_ALIVE})
+        {
+            keys.push_back(storage::TableKey{tableName, key});
+        }
+    }
+    stateStorage->prefetch(
+        m_memoryTableFactory->blockHash(), m_memoryTableFactory->blockNum(), keys);
+}
+
 void StorageState::createAccount(Address const& _address, u256 const& _nonce, u256 const& _amount)
 {
     std::string tableName("_contract_data_" + _address.hex() + "_");
@@ -169,11 +169,17 @@ public:
 
     virtual bool checkAuthority(Address const& _origin, Address const& _contract) const override;
 
+    /// reads the rows of the accounts and of their tables in the system tables by a single
+    /// batch select of the storage
+    virtual void prefetch(std::vector<Address> const& _addresses) override;
+
     void setMemoryTableFactory(
         std::shared_ptr<dev::storage::MemoryTableFactory> _memoryTableFactory)
     {
         m_memoryTableFactory = _memoryTableFactory;
     }
+    /// keep the storage slots in binary, a chain uses one format from its genesis block on
+    void setBinaryStorage(bool _binaryStorage) { m_binaryStorage = _binaryStorage; }
 
 private:
     mutable std::unordered_map<Address, bytes> m_cache;
@@ -182,6 +188,7 @@ private:
     /// check authority by caller
     u256 m_accountStartNonce;
     std::shared_ptr<dev::storage::MemoryTableFactory> m_memoryTableFactory;
+    bool m_binaryStorage = false;
 };
 }  // namespace storagestate
 }  // namespace dev
@@ -37,9 +37,12 @@ public:
     virtual ~StorageStateFactory() {}
     std::shared_ptr<dev::executive::StateFace> getState(
         h256 const& _root, std::shared_ptr<dev::storage::MemoryTableFactory> _factory) override;
+    /// the states keep the storage slots in binary, fixed when the chain is created
+    void setBinaryStorage(bool _binaryStorage) { m_binaryStorage = _binaryStorage; }
 
 private:
     u256 m_accountStartNonce;
+    bool m_binaryStorage = false;
 };
 }  // namespace storagestate
 }  // namespace dev
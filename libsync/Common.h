@@ -35,6 +35,7 @@
 #include <libethcore/Block.h>
 
 
+#include <atomic>
 #include <set>
 
 namespace dev
@@ -62,6 +63,8 @@ static size_t const c_maxPayload = dev::p2p::P2PMessage::MAX_LENGTH - 2048;
 
 static uint64_t const c_maintainBlocksTimeout = 5000;  // ms
 
+static uint64_t const c_pipelineReportInterval = 30000;  // ms
+
 using NodeList = std::set<dev::p2p::NodeID>;
 using NodeID = dev::p2p::NodeID;
 using NodeIDs = std::vector<dev::p2p::NodeID>;
@@ -88,6 +91,30 @@ enum class SyncState
     Size          /// Must be kept last
 };
 
+/// blocks, transactions and busy time of a stage of the download pipeline
+struct SyncStageStats
+{
+    std::atomic<uint64_t> blocks = {0};
+    std::atomic<uint64_t> txs = {0};
+    std::atomic<uint64_t> busyUs = {0};
+
+    void add(uint64_t _blocks, uint64_t _txs, double _seconds)
+    {
+        blocks += _blocks;
+        txs += _txs;
+        busyUs += uint64_t(_seconds * 1000000);
+    }
+    void reset()
+    {
+        blocks = 0;
+        txs = 0;
+        busyUs = 0;
+    }
+    /// blocks per second of busy time
+    double blockRate() const { return busyUs ? blocks * 1000000.0 / busyUs : 0; }
+    double txRate() const { return busyUs ? txs * 1000000.0 / busyUs : 0; }
+};
+
 struct SyncPeerInfo
 {
     NodeID nodeId;
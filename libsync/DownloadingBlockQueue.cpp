@@ -114,6 +114,7 @@ void DownloadingBlockQueue::clearQueue()
     WriteGuard l(x_blocks);
     std::priority_queue<BlockPtr, BlockPtrVec, BlockQueueCmp> emptyQueue;
     swap(m_blocks, emptyQueue);  // Does memory leak here ?
+    ++m_generation;
 }
 
 void DownloadingBlockQueue::flushBufferToQueue()
@@ -125,49 +126,110 @@ void DownloadingBlockQueue::flushBufferToQueue()
         m_buffer = make_shared<ShardPtrVec>();  // m_buffer point to a new vector
     }
 
-    // pop buffer into queue
-    WriteGuard l(x_blocks);
+    size_t queueSize;
+    uint64_t generation;
+    {
+        ReadGuard l(x_blocks);
+        queueSize = m_blocks.size();
+        generation = m_generation;
+    }
+    // the blocks being decoded will be in the queue soon
+    queueSize += m_verifying;
 
     for (ShardPtr blocksShard : *localBuffer)
     {
-        if (m_blocks.size() >= c_maxDownloadingBlockQueueSize)  // TODO not to use size to control
-                                                                // insert
+        if (queueSize >= c_maxDownloadingBlockQueueSize)  // TODO not to use size to control
+                                                          // insert
         {
             SYNCLOG(TRACE)
                 << "[Download] [BlockSync] DownloadingBlockQueueBuffer is full with size "
-                << m_blocks.size();
+                << queueSize;
             break;
         }
 
         SYNCLOG(TRACE) << "[Download] [BlockSync] Decoding block buffer [size]: "
                        << blocksShard->blocksBytes.size() << endl;
 
-        RLP const& rlps = RLP(ref(blocksShard->blocksBytes));
-        unsigned itemCount = rlps.itemCount();
-        size_t successCnt = 0;
-        for (unsigned i = 0; i < itemCount; ++i)
+        if (!m_verifyPool)
         {
-            try
+            importShard(blocksShard, generation);
+            ReadGuard l(x_blocks);
+            queueSize = m_blocks.size();
+            continue;
+        }
+
+        size_t itemCount = RLP(ref(blocksShard->blocksBytes)).itemCount();
+        queueSize += itemCount;
+        m_verifying += itemCount;
+        m_verifyPool->enqueue([this, blocksShard, generation, itemCount]() {
+            importShard(blocksShard, generation);
+            m_verifying -= itemCount;
+            if (m_onReady)
             {
-                shared_ptr<Block> block = make_shared<Block>(rlps[i].toBytes());
-                if (isNewerBlock(block))
-                {
-                    successCnt++;
-                    m_blocks.push(block);
-                }
+                m_onReady();
             }
-            catch (std::exception& e)
+        });
+    }
+}
+
+void DownloadingBlockQueue::importShard(ShardPtr _shard, uint64_t _generation)
+{
+    Timer timer;
+    RLP const& rlps = RLP(ref(_shard->blocksBytes));
+    unsigned itemCount = rlps.itemCount();
+    BlockPtrVec blocks;
+    size_t txs = 0;
+    for (unsigned i = 0; i < itemCount; ++i)
+    {
+        try
+        {
+            // checks the signatures of the transactions and recovers their senders
+            shared_ptr<Block> block = make_shared<Block>(rlps[i].toBytes());
+            if (isNewerBlock(block))
             {
-                SYNCLOG(WARNING)
-                    << "[Download] [BlockSync] Invalid block RLP [reason/RLPDataSize]: " << e.what()
-                    << "/" << rlps.data().size() << endl;
-                continue;
+                txs += block->transactions().size();
+                blocks.push_back(block);
             }
         }
+        catch (std::exception& e)
+        {
+            SYNCLOG(WARNING) << "[Download] [BlockSync] Invalid block RLP [reason/RLPDataSize]: "
+                             << e.what() << "/" << rlps.data().size() << endl;
+            continue;
+        }
+    }
+    m_verifyStats.add(blocks.size(), txs, timer.elapsed());
 
-        SYNCLOG(TRACE) << "[Download] [BlockSync] Flush buffer to block queue "
-                          "[import/rcv/downloadBlockQueue]: "
-                       << successCnt << "/" << itemCount << "/" << m_blocks.size() << endl;
+    size_t queueSize;
+    {
+        WriteGuard l(x_blocks);
+        if (_generation != m_generation)
+        {
+            return;
+        }
+        for (auto& block : blocks)
+        {
+            m_blocks.push(block);
+        }
+        queueSize = m_blocks.size();
+    }
+
+    SYNCLOG(TRACE) << "[Download] [BlockSync] Flush buffer to block queue "
+                      "[import/rcv/downloadBlockQueue]: "
+                   << blocks.size() << "/" << itemCount << "/" << queueSize << endl;
+}
+
+void DownloadingBlockQueue::setVerifyThreads(
+    size_t _threadNum, std::function<void()> const& _onReady)
+{
+    // waits for the running decodings, the queued ones are dropped and downloaded again
+    m_verifyPool = nullptr;
+    m_verifying = 0;
+    m_onReady = _onReady;
+    if (_threadNum > 0)
+    {
+        m_verifyPool = std::make_shared<dev::ThreadPool>(
+            "SyncVerify-" + std::to_string(m_groupId), _threadNum);
     }
 }
 
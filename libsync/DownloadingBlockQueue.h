@@ -24,8 +24,10 @@
 #include "Common.h"
 #include <libblockchain/BlockChainInterface.h>
 #include <libdevcore/Guards.h>
+#include <libdevcore/ThreadPool.h>
 #include <libethcore/Block.h>
 #include <climits>
+#include <functional>
 #include <queue>
 #include <set>
 #include <vector>
@@ -105,6 +107,16 @@ public:
 
     void clearFullQueueIfNotHas(int64_t _blockNumber);
 
+    /// decode the flushed blocks, which recovers the senders of their transactions, on
+    /// _threadNum threads in the background, _onReady is called after the blocks of a shard
+    /// are pushed into the queue
+    /// 0 decodes them in flushBufferToQueue()
+    void setVerifyThreads(size_t _threadNum, std::function<void()> const& _onReady);
+
+    /// the blocks decoded into the queue
+    SyncStageStats const& verifyStats() const { return m_verifyStats; }
+    void resetVerifyStats() { m_verifyStats.reset(); }
+
 private:
     std::shared_ptr<dev::blockchain::BlockChainInterface> m_blockChain;
     PROTOCOL_ID m_protocolId;
@@ -116,8 +128,20 @@ private:
     mutable SharedMutex x_blocks;
     mutable SharedMutex x_buffer;
 
+    /// incremented by clearQueue() to drop the blocks decoded for the cleared queue, protected by
+    /// x_blocks
+    uint64_t m_generation = 0;
+    /// blocks of the shards being decoded by m_verifyPool
+    std::atomic<size_t> m_verifying = {0};
+    SyncStageStats m_verifyStats;
+    std::function<void()> m_onReady;
+    /// destroyed first, the running decodings use the other members
+    std::shared_ptr<dev::ThreadPool> m_verifyPool;
+
 private:
     bool isNewerBlock(std::shared_ptr<dev::eth::Block> _block);
+    /// decode the blocks of _shard into the queue unless it was cleared after _generation
+    void importShard(ShardPtr _shard, uint64_t _generation);
 };
 
 }  // namespace sync
@@ -52,6 +52,29 @@ void SyncMaster::printSyncInfo()
     SYNCLOG(TRACE) << "            --------------------------------------------" << endl;
 }
 
+void SyncMaster::resetPipelineStats()
+{
+    m_syncStatus->bq().resetVerifyStats();
+    m_executeStats.reset();
+    m_commitStats.reset();
+    m_pipelineTimer.restart();
+    m_pipelineReportTime = utcTime() + c_pipelineReportInterval;
+}
+
+void SyncMaster::printPipelineStats()
+{
+    m_pipelineReportTime = utcTime() + c_pipelineReportInterval;
+    auto const& verify = m_syncStatus->bq().verifyStats();
+    double elapsed = m_pipelineTimer.elapsed();
+    // the rates are per busy second, the verify time is summed over its threads
+    SYNCLOG(INFO) << "[Download] [BlockSync] Pipeline [committed/elapsed]: "
+                  << m_commitStats.blocks << "/" << elapsed << "s"
+                  << " [verify/execute/commit] blocks/s: " << verify.blockRate() << "/"
+                  << m_executeStats.blockRate() << "/" << m_commitStats.blockRate()
+                  << " txs/s: " << verify.txRate() << "/" << m_executeStats.txRate() << "/"
+                  << m_commitStats.txRate();
+}
+
 SyncStatus SyncMaster::status() const
 {
     ReadGuard l(x_sync);
@@ -382,21 +405,35 @@ bool SyncMaster::maintainDownloadingQueue()
 
     // pop block in sequence and ignore block which number is lower than currentNumber +1
     BlockPtr topBlock = bq.top();
+    // the block committed last, the parent of the next one
+    BlockInfo parentBlockInfo{h256(), -1, h256()};
     while (topBlock != nullptr && topBlock->header().number() <= (m_blockChain->number() + 1))
     {
         try
         {
             if (isNewBlock(topBlock))
             {
-                auto parentBlock =
-                    m_blockChain->getBlockByNumber(topBlock->blockHeader().number() - 1);
-                BlockInfo parentBlockInfo{parentBlock->header().hash(),
-                    parentBlock->header().number(), parentBlock->header().stateRoot()};
+                if (parentBlockInfo.hash != topBlock->header().parentHash())
+                {
+                    auto parentBlock =
+                        m_blockChain->getBlockByNumber(topBlock->blockHeader().number() - 1);
+                    parentBlockInfo = BlockInfo{parentBlock->header().hash(),
+                        parentBlock->header().number(), parentBlock->header().stateRoot()};
+                }
+                size_t txs = topBlock->transactions().size();
+                Timer timer;
                 ExecutiveContext::Ptr exeCtx =
                     m_blockVerifier->executeBlock(*topBlock, parentBlockInfo);
+                m_executeStats.add(1, txs, timer.elapsed());
+                // the storage writes the block to disk in the background, the next block
+                // executes in the meantime
+                timer.restart();
                 CommitResult ret = m_blockChain->commitBlock(*topBlock, exeCtx);
+                m_commitStats.add(1, txs, timer.elapsed());
                 if (ret == CommitResult::OK)
                 {
+                    parentBlockInfo = BlockInfo{topBlock->header().hash(),
+                        topBlock->header().number(), topBlock->header().stateRoot()};
                     m_txPool->dropBlockTrans(*topBlock);
                     SYNCLOG(DEBUG)
                         << "[Download] [BlockSync] Download block commit [number/txs/hash]: "
@@ -437,6 +474,7 @@ bool SyncMaster::maintainDownloadingQueue()
     currentNumber = m_blockChain->number();
     if (currentNumber >= m_syncStatus->knownHighestNumber)
     {
+        printPipelineStats();
         h256 const& latestHash =
             m_blockChain->getBlockByNumber(m_syncStatus->knownHighestNumber)->headerHash();
         SYNCLOG(TRACE) << "[Download] [BlockSync] Download finish. Latest hash: " << latestHash
@@ -448,6 +486,11 @@ bool SyncMaster::maintainDownloadingQueue()
                            << endl;
         return true;
     }
+
+    if (utcTime() > m_pipelineReportTime)
+    {
+        printPipelineStats();
+    }
     return false;
 }
 
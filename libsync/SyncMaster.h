@@ -37,6 +37,7 @@
 #include <libnetwork/Session.h>
 #include <libp2p/P2PInterface.h>
 #include <libtxpool/TxPoolInterface.h>
+#include <thread>
 #include <vector>
 
 
@@ -52,7 +53,7 @@ public:
         std::shared_ptr<dev::blockchain::BlockChainInterface> _blockChain,
         std::shared_ptr<dev::blockverifier::BlockVerifierInterface> _blockVerifier,
         PROTOCOL_ID const& _protocolId, NodeID const& _nodeId, h256 const& _genesisHash,
-        unsigned _idleWaitMs = 200)
+        unsigned _idleWaitMs = 200, size_t _verifyThreads = std::thread::hardware_concurrency())
       : SyncInterface(),
         Worker("SyncMaster-" + std::to_string(_protocolId), _idleWaitMs),
         m_service(_service),
@@ -71,9 +72,18 @@ public:
         m_tqReady = m_txPool->onReady([&]() { this->noteNewTransactions(); });
         m_blockSubmitted = m_blockChain->onReady([&]() { this->noteNewBlocks(); });
         m_groupId = dev::eth::getGroupAndProtocol(m_protocolId).first;
+
+        // decode the downloaded blocks while the previous ones execute, 0 decodes them on the
+        // sync thread
+        m_syncStatus->bq().setVerifyThreads(_verifyThreads, [&]() { m_signalled.notify_all(); });
     }
 
-    virtual ~SyncMaster() { stop(); };
+    virtual ~SyncMaster()
+    {
+        stop();
+        // the queue may outlive this object
+        m_syncStatus->bq().setVerifyThreads(0, nullptr);
+    };
     /// start blockSync
     virtual void start() override;
     /// stop blockSync
@@ -114,7 +124,10 @@ public:
     void noteDownloadingBegin()
     {
         if (m_syncStatus->state == SyncState::Idle)
+        {
             m_syncStatus->state = SyncState::Downloading;
+            resetPipelineStats();
+        }
     }
 
     void noteDownloadingFinish()
@@ -133,6 +146,10 @@ public:
 
     std::shared_ptr<SyncMsgEngine> msgEngine() { return m_msgEngine; }
 
+    /// the blocks executed and committed by the download pipeline
+    SyncStageStats const& executeStats() const { return m_executeStats; }
+    SyncStageStats const& commitStats() const { return m_commitStats; }
+
 private:
     /// p2p service handler
     std::shared_ptr<dev::p2p::P2PInterface> m_service;
@@ -173,6 +190,13 @@ private:
     bool m_newBlocks = false;
     uint64_t m_maintainBlocksTimeout = 0;
 
+    // download pipeline: the blocks are decoded by the verify threads of the queue, then
+    // executed and committed here
+    SyncStageStats m_executeStats;
+    SyncStageStats m_commitStats;
+    Timer m_pipelineTimer;
+    uint64_t m_pipelineReportTime = 0;
+
 
     // settings
     dev::eth::Handler<> m_tqReady;
@@ -193,6 +217,9 @@ public:
 private:
     bool isNewBlock(BlockPtr _block);
     void printSyncInfo();
+    void resetPipelineStats();
+    /// log the throughput of each stage of the download pipeline
+    void printPipelineStats();
 };
 
 }  // namespace sync
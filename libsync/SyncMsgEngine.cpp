@@ -172,39 +172,43 @@ void SyncMsgEngine::onPeerTransactions(SyncMsgPacket const& _packet)
 
     size_t successCnt = 0;
 
+    /// decoded and verified by the txpool workers
+    std::vector<bytesConstRef> txsBytes;
+    txsBytes.reserve(itemCount);
     for (unsigned i = 0; i < itemCount; ++i)
     {
-        try
+        txsBytes.push_back(rlps[i].data());
+    }
+    auto importResults = m_txPool->batchImport(txsBytes);
+
+    for (unsigned i = 0; i < itemCount; ++i)
+    {
+        auto importResult = importResults[i].first;
+        auto const& txHash = importResults[i].second;
+        if (ImportResult::Success == importResult)
+            successCnt++;
+        else if (ImportResult::Malformed == importResult)
         {
-            Transaction tx;
-            tx.decode(rlps[i]);
-
-            auto importResult = m_txPool->import(tx);
-            if (ImportResult::Success == importResult)
-                successCnt++;
-            else if (ImportResult::AlreadyKnown == importResult)
-            {
-                SYNCLOG(TRACE) << "[Tx] Import peer transaction into txPool DUPLICATED from peer "
-                                  "[reason/txHash/peer]: "
-                               << int(importResult) << "/" << _packet.nodeId.abridged() << "/"
-                               << move(tx.sha3()) << endl;
-            }
-            else
-            {
-                SYNCLOG(TRACE) << "[Tx] Import peer transaction into txPool FAILED from peer "
-                                  "[reason/txHash/peer]: "
-                               << int(importResult) << "/" << _packet.nodeId.abridged() << "/"
-                               << move(tx.sha3()) << endl;
-            }
-
-            m_txPool->transactionIsKnownBy(tx.sha3(), _packet.nodeId);
+            SYNCLOG(WARNING) << "[Tx] Invalid transaction RLP recieved [rlp] "
+                             << toHex(rlps[i].toBytes()) << endl;
+            continue;
         }
-        catch (std::exception& e)
+        else if (ImportResult::AlreadyKnown == importResult)
         {
-            SYNCLOG(WARNING) << "[Tx] Invalid transaction RLP recieved [reason/rlp] " << e.what()
-                             << "/" << toHex(rlps[i].toBytes()) << endl;
-            continue;
+            SYNCLOG(TRACE) << "[Tx] Import peer transaction into txPool DUPLICATED from peer "
+                              "[reason/txHash/peer]: "
+                           << int(importResult) << "/" << _packet.nodeId.abridged() << "/"
+                           << txHash << endl;
+        }
+        else
+        {
+            SYNCLOG(TRACE) << "[Tx] Import peer transaction into txPool FAILED from peer "
+                              "[reason/txHash/peer]: "
+                           << int(importResult) << "/" << _packet.nodeId.abridged() << "/"
+                           << txHash << endl;
         }
+
+        m_txPool->transactionIsKnownBy(txHash, _packet.nodeId);
     }
 
     auto pengdingSize = m_txPool->pendingSize();
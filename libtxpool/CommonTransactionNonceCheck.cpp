@@ -28,9 +28,13 @@ namespace txpool
 {
 std::string CommonTransactionNonceCheck::generateKey(Transaction const& _t)
 {
-    Address account = _t.from();
-    std::string key = toHex(account.ref());
-    key += "_" + toString(_t.nonce());
+    return generateKey(_t.from(), _t.nonce());
+}
+
+std::string CommonTransactionNonceCheck::generateKey(Address const& _sender, u256 const& _nonce)
+{
+    std::string key = toHex(_sender.ref());
+    key += "_" + toString(_nonce);
     return key;
 }
 
@@ -46,6 +46,7 @@ public:
     virtual bool isNonceOk(dev::eth::Transaction const& _trans, bool needInsert = false);
 
     std::string generateKey(dev::eth::Transaction const& _t);
+    std::string generateKey(dev::Address const& _sender, dev::u256 const& _nonce);
 
 protected:
     dev::PROTOCOL_ID m_protocolId;
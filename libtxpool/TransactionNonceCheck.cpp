@@ -88,12 +88,10 @@ void TransactionNonceCheck::updateCache(bool _rebuild)
             {
                 for (unsigned i = prestartblk; i < m_startblk; i++)
                 {
-                    h256 blockhash = m_blockChain->numberHash(i);
-
-                    Transactions trans = m_blockChain->getBlockByHash(blockhash)->transactions();
-                    for (unsigned j = 0; j < trans.size(); j++)
+                    auto nonces = m_blockChain->getBlockNonces(i);
+                    for (auto const& nonce : *nonces)
                     {
-                        std::string key = this->generateKey(trans[j]);
+                        std::string key = this->generateKey(nonce.first, nonce.second);
                         auto iter = m_cache.find(key);
                         if (iter != m_cache.end())
                             m_cache.erase(iter);
@@ -102,15 +100,10 @@ void TransactionNonceCheck::updateCache(bool _rebuild)
             }
             for (unsigned i = std::max(preendblk + 1, m_startblk); i <= m_endblk; i++)
             {
-                h256 blockhash = m_blockChain->numberHash(i);
-
-                Transactions trans = m_blockChain->getBlockByHash(blockhash)->transactions();
-                for (unsigned j = 0; j < trans.size(); j++)
+                auto nonces = m_blockChain->getBlockNonces(i);
+                for (auto const& nonce : *nonces)
                 {
-                    std::string key = this->generateKey(trans[j]);
-                    auto iter = m_cache.find(key);
-                    if (iter == m_cache.end())
-                        m_cache.insert(key);
+                    m_cache.insert(this->generateKey(nonce.first, nonce.second));
                 }  // for
             }      // for
             NONCECHECKER_LOG(TRACE) << "[#updateCache] [cacheSize/costTime]:  " << m_cache.size()
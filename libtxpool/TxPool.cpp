@@ -22,7 +22,10 @@
  * @date: 2018-09-23
  */
 #include "TxPool.h"
+#include <libdevcore/Common.h>
 #include <libethcore/Exceptions.h>
+#include <condition_variable>
+#include <mutex>
 using namespace std;
 using namespace dev::p2p;
 using namespace dev::eth;
@@ -89,18 +92,11 @@ std::pair<h256, Address> TxPool::submit(Transaction& _tx)
 ImportResult TxPool::import(bytesConstRef _txBytes, IfDropped _ik)
 {
     Transaction tx;
-    try
-    {
-        tx.decode(_txBytes, CheckTransaction::Everything);
-        /// check sha3
-        if (sha3(_txBytes.toBytes()) != tx.sha3())
-            return ImportResult::Malformed;
-    }
-    catch (std::exception& e)
+    ImportResult ret = decodeTransaction(_txBytes, tx);
+    if (ret != ImportResult::Success)
     {
-        TXPOOL_LOG(ERROR) << "[#import] import transaction failed, [EINFO]:  "
-                          << boost::diagnostic_information(e) << std::endl;
-        return ImportResult::Malformed;
+        countResult(ret);
+        return ret;
     }
     return import(tx, _ik);
 }
@@ -114,60 +110,191 @@ ImportResult TxPool::import(bytesConstRef _txBytes, IfDropped _ik)
  */
 ImportResult TxPool::import(Transaction& _tx, IfDropped _ik)
 {
-    _tx.setImportTime(u256(utcTime()));
-    UpgradableGuard l(m_lock);
-    /// check the txpool size
-    if (m_txsQueue.size() >= m_limit)
-        return ImportResult::TransactionPoolIsFull;
     /// check the verify result(nonce && signature check)
-    ImportResult verify_ret = verify(_tx);
+    ImportResult verify_ret = verify(_tx, _ik);
     if (verify_ret == ImportResult::Success)
     {
-        UpgradeGuard ul(l);
-        if (insert(_tx))
+        WriteGuard l(m_lock);
+        verify_ret = insertVerified(_tx, _ik);
+    }
+    if (verify_ret == ImportResult::Success)
+    {
+        m_onReady();
+    }
+    countResult(verify_ret);
+    return verify_ret;
+}
+
+std::vector<std::pair<ImportResult, h256>> TxPool::batchImport(
+    std::vector<bytesConstRef> const& _txsBytes, IfDropped _ik)
+{
+    Timer timer;
+    std::vector<std::pair<ImportResult, h256>> results(_txsBytes.size());
+    Transactions txs(_txsBytes.size());
+
+    /// decode, recover the sender and check the nonce on the workers
+    std::mutex lock;
+    std::condition_variable finished;
+    size_t pending = _txsBytes.size();
+    m_verifyingTxs += _txsBytes.size();
+    for (size_t i = 0; i < _txsBytes.size(); ++i)
+    {
+        m_workerPool->enqueue([&, i]() {
+            try
+            {
+                results[i].second = sha3(_txsBytes[i]);
+                results[i].first = decodeTransaction(_txsBytes[i], txs[i]);
+                if (results[i].first == ImportResult::Success)
+                    results[i].first = verify(txs[i], _ik);
+            }
+            catch (...)
+            {
+                TXPOOL_LOG(WARNING) << "[#batchImport] verify transaction failed, [EINFO]:  "
+                                    << boost::current_exception_diagnostic_information()
+                                    << std::endl;
+                results[i].first = ImportResult::Malformed;
+            }
+            --m_verifyingTxs;
+            std::lock_guard<std::mutex> l(lock);
+            --pending;
+            finished.notify_all();
+        });
+    }
+    {
+        std::unique_lock<std::mutex> l(lock);
+        finished.wait(l, [&]() { return pending == 0; });
+    }
+
+    /// insert in the order of the batch
+    size_t successCnt = 0;
+    {
+        WriteGuard l(m_lock);
+        for (size_t i = 0; i < txs.size(); ++i)
         {
-            m_commonNonceCheck->insertCache(_tx);
-            m_onReady();
+            if (results[i].first == ImportResult::Success)
+            {
+                results[i].first = insertVerified(txs[i], _ik);
+            }
+            if (results[i].first == ImportResult::Success)
+            {
+                ++successCnt;
+            }
         }
     }
-    return verify_ret;
+    for (auto const& result : results)
+    {
+        countResult(result.first);
+    }
+    if (successCnt > 0)
+    {
+        m_onReady();
+    }
+    TXPOOL_LOG(DEBUG) << "[#batchImport] [batch/success/verifying/costMs]: " << _txsBytes.size()
+                      << "/" << successCnt << "/" << m_verifyingTxs.load() << "/"
+                      << (timer.elapsed() * 1000) << std::endl;
+    return results;
+}
+
+ImportResult TxPool::decodeTransaction(bytesConstRef _txBytes, Transaction& _tx)
+{
+    try
+    {
+        _tx.decode(_txBytes, CheckTransaction::Everything);
+        /// check sha3
+        if (sha3(_txBytes) != _tx.sha3())
+            return ImportResult::Malformed;
+    }
+    catch (std::exception& e)
+    {
+        TXPOOL_LOG(ERROR) << "[#import] import transaction failed, [EINFO]:  "
+                          << boost::diagnostic_information(e) << std::endl;
+        return ImportResult::Malformed;
+    }
+    return ImportResult::Success;
 }
 
 /**
  * @brief : verify specified transaction, including:
- *  1. whether the transaction is known (refuse repeated transaction)
- *  2. check nonce
- *  3. check block limit
+ *  1. check the txpool size
+ *  2. whether the transaction is known (refuse repeated transaction)
+ *  3. check nonce
+ *  4. check block limit
  *  TODO: check transaction filter
+ *  The nonce cache of the txpool is checked by insertVerified, which also checks the nonce and
+ *  the block limit again in case a block was committed meanwhile
  *
  * @param trans : the transaction to be verified
  * @param _drop_policy : Import transaction policy
  * @return ImportResult : import result
  */
-ImportResult TxPool::verify(Transaction const& trans, IfDropped _drop_policy, bool _needinsert)
+ImportResult TxPool::verify(Transaction const& trans, IfDropped _drop_policy)
+{
+    {
+        ReadGuard l(m_lock);
+        /// check the txpool size
+        if (m_txsQueue.size() >= m_limit)
+            return ImportResult::TransactionPoolIsFull;
+        ImportResult ret = checkKnown(trans.sha3(), _drop_policy);
+        if (ret != ImportResult::Success)
+            return ret;
+    }
+    /// check nonce, the nonce checkers hold their own locks
+    if (false == isBlockLimitOrNonceOk(trans, false))
+        return ImportResult::TransactionNonceCheckFail;
+    /// TODO: filter check
+    return ImportResult::Success;
+}
+
+ImportResult TxPool::checkKnown(h256 const& _txHash, IfDropped _drop_policy) const
 {
     /// check whether this transaction has been existed
-    h256 tx_hash = trans.sha3();
-    if (m_known.count(tx_hash))
+    if (m_known.count(_txHash))
     {
-        TXPOOL_LOG(WARNING) << "[#Verify] already known tx: " << tx_hash.abridged() << std::endl;
+        TXPOOL_LOG(WARNING) << "[#Verify] already known tx: " << _txHash.abridged() << std::endl;
         return ImportResult::AlreadyKnown;
     }
     /// the transaction has been dropped before
-    if (m_dropped.count(tx_hash) && _drop_policy == IfDropped::Ignore)
+    if (m_dropped.count(_txHash) && _drop_policy == IfDropped::Ignore)
     {
-        TXPOOL_LOG(WARNING) << "[#Verify] already dropped tx: " << tx_hash.abridged() << std::endl;
+        TXPOOL_LOG(WARNING) << "[#Verify] already dropped tx: " << _txHash.abridged() << std::endl;
         return ImportResult::AlreadyInChain;
     }
-    /// check nonce
-    if (false == isBlockLimitOrNonceOk(trans, _needinsert))
+    return ImportResult::Success;
+}
+
+ImportResult TxPool::insertVerified(Transaction const& _tx, IfDropped _ik)
+{
+    /// the pool may have changed since verify
+    if (m_txsQueue.size() >= m_limit)
+        return ImportResult::TransactionPoolIsFull;
+    ImportResult ret = checkKnown(_tx.sha3(), _ik);
+    if (ret != ImportResult::Success)
+        return ret;
+    /// a block committed after verify has been evicted from the pool already, the transaction
+    /// must not use its nonces or expire with it
+    if (_tx.blockLimit() <= u256(m_committedNumber) || !m_txNonceCheck->isNonceOk(_tx, false))
+    {
+        TXPOOL_LOG(WARNING) << "[#insertVerified] invalid after block committed: [number/tx]:  "
+                            << m_committedNumber << "/" << _tx.sha3().abridged() << std::endl;
         return ImportResult::TransactionNonceCheckFail;
-    if (false == txPoolNonceCheck(trans))
+    }
+    if (false == txPoolNonceCheck(_tx))
         return ImportResult::TxPoolNonceCheckFail;
-    /// TODO: filter check
+    if (insert(_tx))
+    {
+        m_commonNonceCheck->insertCache(_tx);
+    }
     return ImportResult::Success;
 }
 
+void TxPool::countResult(ImportResult _result)
+{
+    if (_result == ImportResult::Success)
+        ++m_importedTxs;
+    else
+        ++m_rejectedTxs;
+}
+
 /**
  * @brief: check the nonce
  * @param _tx : the transaction to be checked
@@ -197,11 +324,23 @@ bool TxPool::removeTrans(h256 const& _txHash, bool needTriggerCallback,
     {
         return false;
     }
-    /// trigger callback from RPC
-    if (needTriggerCallback && pReceipt)
+    Transaction const& tx = p_tx->second->second;
+    /// trigger callback from RPC after the block is durable
+    if (needTriggerCallback && pReceipt && tx.rpcCallback())
+    {
+        Guard l(x_pendingCallbacks);
+        m_pendingCallbacks[pReceipt->blockNumber()].emplace_back(tx.rpcCallback(), pReceipt);
+    }
+    auto p_limit = m_blockLimitIndex.find(tx.blockLimit());
+    if (p_limit != m_blockLimitIndex.end())
     {
-        p_tx->second->tiggerRpcCallback(pReceipt);
+        p_limit->second.erase(_txHash);
+        if (p_limit->second.empty())
+            m_blockLimitIndex.erase(p_limit);
     }
+    auto p_nonce = m_nonceKeyIndex.find(m_commonNonceCheck->generateKey(tx));
+    if (p_nonce != m_nonceKeyIndex.end() && p_nonce->second == _txHash)
+        m_nonceKeyIndex.erase(p_nonce);
     m_txsQueue.erase(p_tx->second);
     m_txsHash.erase(p_tx);
     if (m_known.count(_txHash))
@@ -223,8 +362,12 @@ bool TxPool::insert(Transaction const& _tx)
         return false;
     }
     m_known.insert(tx_hash);
-    TransactionQueue::iterator p_tx = m_txsQueue.emplace(_tx).first;
+    /// queued in insert order, the import time follows the same order
+    TransactionQueue::iterator p_tx = m_txsQueue.emplace_hint(m_txsQueue.end(), ++m_lastSeq, _tx);
+    p_tx->second.setImportTime(u256(utcTime()));
     m_txsHash[tx_hash] = p_tx;
+    m_blockLimitIndex[_tx.blockLimit()].insert(tx_hash);
+    m_nonceKeyIndex[m_commonNonceCheck->generateKey(_tx)] = tx_hash;
     return true;
 }
 
@@ -289,11 +432,82 @@ bool TxPool::dropBlockTrans(Block const& block)
     /// update the nonce check related to block chain
     m_txNonceCheck->updateCache(false);
     bool ret = dropTransactions(block, true);
+    /// the block may have been persisted before its callbacks were queued
+    triggerCallbacks(m_blockChain->durableNumber());
+    size_t evicted = 0;
+    {
+        WriteGuard l(m_lock);
+        m_committedNumber = std::max(m_committedNumber, block.blockHeader().number());
+        evicted = evictInvalidTransactions(block);
+    }
     /// remove the nonce check related to txpool
     m_commonNonceCheck->delCache(block.transactions());
+    if (evicted > 0)
+    {
+        TXPOOL_LOG(DEBUG) << "[#dropBlockTrans] evict invalid transactions [number/evicted]: "
+                          << block.blockHeader().number() << "/" << evicted << std::endl;
+    }
     return ret;
 }
 
+void TxPool::triggerCallbacks(int64_t _durableNumber)
+{
+    Callbacks callbacks;
+    {
+        Guard l(x_pendingCallbacks);
+        auto end = m_pendingCallbacks.upper_bound(_durableNumber);
+        for (auto it = m_pendingCallbacks.begin(); it != end; ++it)
+        {
+            callbacks.insert(callbacks.end(), it->second.begin(), it->second.end());
+        }
+        m_pendingCallbacks.erase(m_pendingCallbacks.begin(), end);
+    }
+    for (auto const& callback : callbacks)
+    {
+        try
+        {
+            callback.first(callback.second);
+        }
+        catch (std::exception& e)
+        {
+            TXPOOL_LOG(WARNING) << "[#triggerCallbacks] RPC callback failed [tx]: "
+                                << callback.second->hash() << " " << e.what() << std::endl;
+        }
+    }
+}
+
+size_t TxPool::evictInvalidTransactions(Block const& block)
+{
+    std::vector<h256> invalidTxs;
+    /// queued transactions reusing the nonce of a committed transaction
+    for (auto const& tx : block.transactions())
+    {
+        auto p_nonce = m_nonceKeyIndex.find(m_commonNonceCheck->generateKey(tx));
+        if (p_nonce != m_nonceKeyIndex.end())
+            invalidTxs.push_back(p_nonce->second);
+    }
+    /// queued transactions whose block limit is not above the committed number
+    u256 number = u256(block.blockHeader().number());
+    for (auto it = m_blockLimitIndex.begin();
+         it != m_blockLimitIndex.end() && it->first <= number; ++it)
+    {
+        invalidTxs.insert(invalidTxs.end(), it->second.begin(), it->second.end());
+    }
+
+    size_t evicted = 0;
+    for (auto const& txHash : invalidTxs)
+    {
+        auto p_tx = m_txsHash.find(txHash);
+        if (p_tx == m_txsHash.end())
+            continue;
+        m_commonNonceCheck->delCache(m_commonNonceCheck->generateKey(p_tx->second->second));
+        removeTrans(txHash);
+        m_dropped.insert(txHash);
+        ++evicted;
+    }
+    return evicted;
+}
+
 /**
  * @brief Get top transactions from the queue
  *
@@ -308,45 +522,38 @@ dev::eth::Transactions TxPool::topTransactions(uint64_t const& _limit)
     return topTransactions(_limit, _avoid);
 }
 
+/// the queued transactions are valid for the next block: the invalid ones have been evicted by
+/// dropBlockTrans when the last block was committed, so no check is needed here
 Transactions TxPool::topTransactions(uint64_t const& _limit, h256Hash& _avoid, bool _updateAvoid)
 {
-    UpgradableGuard l(m_lock);
+    ReadGuard l(m_lock);
     uint64_t limit = min(m_limit, _limit);
     uint64_t txCnt = 0;
     Transactions ret;
-    std::set<dev::h256> invalidBlockLimitTxs;
-    std::set<std::string> nonceKeyCache;
     for (auto it = m_txsQueue.begin(); txCnt < limit && it != m_txsQueue.end(); it++)
     {
-        /// check block limit and nonce again when obtain transactions
-        if (false == isBlockLimitOrNonceOk(*it, false))
-        {
-            invalidBlockLimitTxs.insert(it->sha3());
-            nonceKeyCache.insert(m_commonNonceCheck->generateKey(*it));
-            continue;
-        }
-        if (!_avoid.count(it->sha3()))
+        h256 txHash = it->second.sha3();
+        if (!_avoid.count(txHash))
         {
-            ret.push_back(*it);
+            ret.push_back(it->second);
             txCnt++;
             if (_updateAvoid)
-                _avoid.insert(it->sha3());
+                _avoid.insert(txHash);
         }
     }
-    if (invalidBlockLimitTxs.size() > 0)
-    {
-        UpgradeGuard ul(l);
-        for (auto txHash : invalidBlockLimitTxs)
-        {
-            removeTrans(txHash);
-            m_dropped.insert(txHash);
-        }
-    }
-    /// delete cached invalid nonce
-    if (nonceKeyCache.size() > 0)
+    return ret;
+}
+
+Transactions TxPool::topTransactions(uint64_t const& _limit, uint64_t& _cursor)
+{
+    ReadGuard l(m_lock);
+    uint64_t limit = min(m_limit, _limit);
+    Transactions ret;
+    for (auto it = m_txsQueue.upper_bound(_cursor); ret.size() < limit && it != m_txsQueue.end();
+         it++)
     {
-        for (auto key : nonceKeyCache)
-            m_commonNonceCheck->delCache(key);
+        ret.push_back(it->second);
+        _cursor = it->first;
     }
     return ret;
 }
@@ -360,15 +567,32 @@ Transactions TxPool::topTransactionsCondition(
     uint64_t txCnt = 0;
     for (auto it = m_txsQueue.begin(); txCnt < limit && it != m_txsQueue.end(); it++)
     {
-        if (_condition(*it))
+        if (_condition(it->second))
         {
-            ret.push_back(*it);
+            ret.push_back(it->second);
             txCnt++;
         }
     }
     return ret;
 }
 
+/// look up the transactions by hash, the indexes of the missing ones are reported in _missed
+Transactions TxPool::getTransactions(h256s const& _txHashes, std::vector<size_t>& _missed)
+{
+    _missed.clear();
+    Transactions ret(_txHashes.size());
+    ReadGuard l(m_lock);
+    for (size_t i = 0; i < _txHashes.size(); i++)
+    {
+        auto it = m_txsHash.find(_txHashes[i]);
+        if (it != m_txsHash.end())
+            ret[i] = it->second->second;
+        else
+            _missed.push_back(i);
+    }
+    return ret;
+}
+
 /// get all transactions(maybe blocksync module need this interface)
 Transactions TxPool::pendingList() const
 {
@@ -376,7 +600,7 @@ Transactions TxPool::pendingList() const
     Transactions ret;
     for (auto t = m_txsQueue.begin(); t != m_txsQueue.end(); ++t)
     {
-        ret.push_back(*t);
+        ret.push_back(t->second);
     }
     return ret;
 }
@@ -395,6 +619,9 @@ TxPoolStatus TxPool::status() const
     ReadGuard l(m_lock);
     status.current = m_txsQueue.size();
     status.dropped = m_dropped.size();
+    status.imported = m_importedTxs.load();
+    status.rejected = m_rejectedTxs.load();
+    status.verifying = m_verifyingTxs.load();
     return status;
 }
 
@@ -405,6 +632,8 @@ void TxPool::clear()
     m_known.clear();
     m_txsQueue.clear();
     m_txsHash.clear();
+    m_blockLimitIndex.clear();
+    m_nonceKeyIndex.clear();
     m_dropped.clear();
     WriteGuard l_trans(x_transactionKnownBy);
     m_transactionKnownBy.clear();
@@ -25,6 +25,7 @@
 #include "TransactionNonceCheck.h"
 #include "TxPoolInterface.h"
 #include <libblockchain/BlockChainInterface.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/easylog.h>
 #include <libethcore/Block.h>
 #include <libethcore/Common.h>
@@ -32,6 +33,9 @@
 #include <libethcore/Transaction.h>
 #include <libp2p/P2PInterface.h>
 #include <libp2p/Service.h>
+#include <atomic>
+#include <map>
+#include <thread>
 using namespace dev::eth;
 using namespace dev::p2p;
 
@@ -49,19 +53,17 @@ struct TxPoolStatus
 {
     size_t current;
     size_t dropped;
+    /// transactions imported/rejected since the node started
+    uint64_t imported = 0;
+    uint64_t rejected = 0;
+    /// transactions waiting for or being verified by the admission workers
+    size_t verifying = 0;
 };
 
 class TxPoolNonceManager
 {
 public:
 };
-struct transactionCompare
-{
-    bool operator()(Transaction const& _first, Transaction const& _second) const
-    {
-        return _first.importTime() <= _second.importTime();
-    }
-};
 class TxPool : public TxPoolInterface, public std::enable_shared_from_this<TxPool>
 {
 public:
@@ -79,6 +81,10 @@ public:
         m_groupId = dev::eth::getGroupAndProtocol(m_protocolId).first;
         m_txNonceCheck = std::make_shared<TransactionNonceCheck>(m_blockChain, m_protocolId);
         m_commonNonceCheck = std::make_shared<CommonTransactionNonceCheck>(m_protocolId);
+        m_committedNumber = m_blockChain->number();
+        m_workerPool = std::make_shared<dev::ThreadPool>(
+            "txPoolWorker", std::max(std::thread::hardware_concurrency(), 1u));
+        m_durable = m_blockChain->onDurable([=](int64_t _num) { this->triggerCallbacks(_num); });
     }
     void setMaxBlockLimit(unsigned const& limit) { m_txNonceCheck->setBlockLimit(limit); }
     unsigned const& maxBlockLimit() { return m_txNonceCheck->maxBlockLimit(); }
@@ -110,9 +116,12 @@ public:
     virtual Transactions topTransactions(uint64_t const& _limit) override;
     virtual Transactions topTransactions(
         uint64_t const& _limit, h256Hash& _avoid, bool _updateAvoid = false) override;
+    virtual Transactions topTransactions(uint64_t const& _limit, uint64_t& _cursor) override;
     virtual Transactions topTransactionsCondition(uint64_t const& _limit,
         std::function<bool(Transaction const&)> const& _condition = nullptr) override;
 
+    /// get the pending transactions with the given hashes
+    Transactions getTransactions(h256s const& _txHashes, std::vector<size_t>& _missed) override;
     /// get all transactions(maybe blocksync module need this interface)
     Transactions pendingList() const override;
     /// get current transaction num
@@ -145,22 +154,44 @@ protected:
      */
     ImportResult import(Transaction& _tx, IfDropped _ik = IfDropped::Ignore) override;
     ImportResult import(bytesConstRef _txBytes, IfDropped _ik = IfDropped::Ignore) override;
-    /// verify transcation
-    virtual ImportResult verify(
-        Transaction const& trans, IfDropped _ik = IfDropped::Ignore, bool _needinsert = false);
+    /**
+     * @brief : decode and verify the transactions on the worker threads, then insert the valid
+     * ones holding the pool lock once
+     *
+     * @param _txsBytes : encoded transactions
+     * @return import result and hash of every transaction, in the order of _txsBytes
+     */
+    std::vector<std::pair<ImportResult, h256>> batchImport(
+        std::vector<bytesConstRef> const& _txsBytes, IfDropped _ik = IfDropped::Ignore) override;
+    /// verify the transaction without the pool write lock
+    virtual ImportResult verify(Transaction const& trans, IfDropped _ik = IfDropped::Ignore);
     /// check nonce
     virtual bool isBlockLimitOrNonceOk(Transaction const& _ts, bool _needinsert) const;
     /// interface for filter check
     virtual u256 filterCheck(const Transaction& _t) const { return u256(0); };
     void clear();
     bool dropTransactions(Block const& block, bool needNotify = false);
+    /// drop the transactions which can't be packed after the block has been committed:
+    /// expired block limit, or nonce used by a transaction of the block
+    /// caller holds the write lock
+    size_t evictInvalidTransactions(Block const& block);
 
 private:
     dev::eth::LocalisedTransactionReceipt::Ptr constructTransactionReceipt(Transaction const& tx,
         dev::eth::TransactionReceipt const& receipt, Block const& block, unsigned index);
 
+    ImportResult decodeTransaction(bytesConstRef _txBytes, Transaction& _tx);
+    /// check whether the transaction is known or dropped, caller holds m_lock
+    ImportResult checkKnown(h256 const& _txHash, IfDropped _ik) const;
+    /// check again and insert a verified transaction, caller holds the write lock
+    ImportResult insertVerified(Transaction const& _tx, IfDropped _ik);
+    void countResult(ImportResult _result);
+
+    /// the RPC callback of the transaction is queued until the block of pReceipt is durable
     bool removeTrans(h256 const& _txHash, bool needTriggerCallback = false,
         dev::eth::LocalisedTransactionReceipt::Ptr pReceipt = nullptr);
+    /// trigger the queued RPC callbacks of the blocks up to _durableNumber
+    void triggerCallbacks(int64_t _durableNumber);
     bool insert(Transaction const& _tx);
     void removeTransactionKnowBy(h256 const& _txHash);
     bool inline txPoolNonceCheck(dev::eth::Transaction const& tx)
@@ -186,10 +217,18 @@ private:
     /// protocolId
     PROTOCOL_ID m_protocolId;
     GROUP_ID m_groupId;
-    /// transaction queue
-    using TransactionQueue = std::set<dev::eth::Transaction, transactionCompare>;
+    /// transaction queue, ordered by the insert sequence
+    using TransactionQueue = std::map<uint64_t, dev::eth::Transaction>;
     TransactionQueue m_txsQueue;
+    uint64_t m_lastSeq = 0;
     std::unordered_map<h256, TransactionQueue::iterator> m_txsHash;
+    /// block limit => queued transactions, for evicting the expired ones when a block is committed
+    std::map<u256, h256Hash> m_blockLimitIndex;
+    /// nonce key => queued transaction
+    std::unordered_map<std::string, h256> m_nonceKeyIndex;
+    /// number of the last block handled by dropBlockTrans, transactions verified before it
+    /// are checked against it again when inserted
+    int64_t m_committedNumber = 0;
     /// hash of imported transactions
     h256Hash m_known;
     /// hash of dropped transactions
@@ -198,6 +237,20 @@ private:
     /// Transaction is known by some peers
     mutable SharedMutex x_transactionKnownBy;
     std::unordered_map<h256, std::set<h512>> m_transactionKnownBy;
+
+    /// admission workers decoding and verifying transactions of batchImport
+    std::shared_ptr<dev::ThreadPool> m_workerPool;
+    std::atomic<uint64_t> m_importedTxs = {0};
+    std::atomic<uint64_t> m_rejectedTxs = {0};
+    std::atomic<size_t> m_verifyingTxs = {0};
+
+    /// block number => RPC callbacks of its transactions, triggered once the block is durable so
+    /// that the receipts can be queried when the callbacks run
+    using Callbacks = std::vector<
+        std::pair<dev::eth::RPCCallback, dev::eth::LocalisedTransactionReceipt::Ptr>>;
+    std::map<int64_t, Callbacks> m_pendingCallbacks;
+    mutable Mutex x_pendingCallbacks;
+    dev::eth::Handler<int64_t> m_durable;
 };
 }  // namespace txpool
 }  // namespace dev
@@ -55,12 +55,40 @@ public:
     virtual dev::eth::Transactions topTransactions(uint64_t const& _limit) = 0;
     virtual dev::eth::Transactions topTransactions(
         uint64_t const& _limit, h256Hash& _avoid, bool _updateAvoid = false) = 0;
+    /**
+     * @brief Get the transactions queued after the cursor, in import order
+     *
+     * @param _limit : Max number of transactions to return.
+     * @param _cursor : position of the last fetched transaction, 0 to start from the oldest one,
+     * moved past the returned transactions
+     * @return Transactions : up to _limit transactions
+     */
+    virtual dev::eth::Transactions topTransactions(uint64_t const& _limit, uint64_t& _cursor)
+    {
+        return dev::eth::Transactions();
+    }
     virtual dev::eth::Transactions topTransactionsCondition(uint64_t const& _limit,
         std::function<bool(dev::eth::Transaction const&)> const& _condition = nullptr)
     {
         return dev::eth::Transactions();
     };
 
+    /**
+     * @brief Get the pending transactions with the given hashes
+     *
+     * @param _txHashes : hashes of the wanted transactions
+     * @param _missed : filled with the indexes of the hashes that are not in the queue
+     * @return Transactions : in the order of _txHashes, empty transactions at the missed indexes
+     */
+    virtual dev::eth::Transactions getTransactions(
+        h256s const& _txHashes, std::vector<size_t>& _missed)
+    {
+        _missed.clear();
+        for (size_t i = 0; i < _txHashes.size(); i++)
+            _missed.push_back(i);
+        return dev::eth::Transactions(_txHashes.size());
+    }
+
     /// get all current transactions(maybe blocksync module need this interface)
     virtual dev::eth::Transactions pendingList() const = 0;
     /// get current transaction num
@@ -84,6 +112,22 @@ public:
         dev::eth::Transaction& _tx, dev::eth::IfDropped _ik = dev::eth::IfDropped::Ignore) = 0;
     virtual dev::eth::ImportResult import(
         bytesConstRef _txBytes, dev::eth::IfDropped _ik = dev::eth::IfDropped::Ignore) = 0;
+    /**
+     * @brief : verify and add a batch of encoded transactions to the queue
+     * @param _txsBytes : encoded transactions
+     * @return import result and hash of every transaction, in the order of _txsBytes
+     */
+    virtual std::vector<std::pair<dev::eth::ImportResult, h256>> batchImport(
+        std::vector<bytesConstRef> const& _txsBytes,
+        dev::eth::IfDropped _ik = dev::eth::IfDropped::Ignore)
+    {
+        std::vector<std::pair<dev::eth::ImportResult, h256>> results;
+        for (auto const& txBytes : _txsBytes)
+        {
+            results.emplace_back(import(txBytes, _ik), sha3(txBytes));
+        }
+        return results;
+    }
     /// @returns the status of the transaction queue.
     virtual TxPoolStatus status() const = 0;
 
@@ -304,6 +304,28 @@ BOOST_AUTO_TEST_CASE(commitBlock)
     BOOST_CHECK_EQUAL(m_blockChainImp->number(), 1);
     BOOST_CHECK_EQUAL(m_blockChainImp->totalTransactionCount().first, 15);
     BOOST_CHECK_EQUAL(m_blockChainImp->totalTransactionCount().second, 1);
+    auto nonces = m_blockChainImp->getBlockNonces(1);
+    BOOST_CHECK_EQUAL(nonces->size(), 10);
+    BOOST_CHECK_EQUAL((*nonces)[0].first, fakeBlock2->getBlock().transactions()[0].from());
+    BOOST_CHECK_EQUAL((*nonces)[0].second, fakeBlock2->getBlock().transactions()[0].nonce());
+
+    /// the block is stored as raw binary and the transactions are decoded one by one
+    auto& tx = fakeBlock2->getBlock().transactions()[0];
+    BOOST_CHECK_EQUAL(m_blockChainImp->getTxByHash(tx.sha3()).sha3(), tx.sha3());
+    /// the sender is taken from the nonce index instead of being recovered
+    BOOST_CHECK_EQUAL(m_blockChainImp->getTxByHash(tx.sha3()).from(), tx.from());
+    auto localisedTx = m_blockChainImp->getLocalisedTxByHash(tx.sha3());
+    BOOST_CHECK_EQUAL(localisedTx.blockNumber(), 1);
+    BOOST_CHECK_EQUAL(localisedTx.transactionIndex(), 0);
+    BOOST_CHECK_EQUAL(sha3(m_blockChainImp->getTransactionReceiptByHash(tx.sha3()).rlp()),
+        sha3(fakeBlock2->getBlock().transactionReceipts()[0].rlp()));
+    /// committed blocks are served from the block cache
+    auto stats = m_blockChainImp->blockCacheStats();
+    BOOST_CHECK_EQUAL(m_blockChainImp->getBlockByNumber(1)->getTransactionSize(), 10);
+    BOOST_CHECK_EQUAL(m_blockChainImp->getBlockByHash(fakeBlock2->getBlock().headerHash()),
+        m_blockChainImp->getBlockByNumber(1));
+    BOOST_CHECK_EQUAL(m_blockChainImp->blockCacheStats().hit, stats.hit + 3);
+    BOOST_CHECK_EQUAL(m_blockChainImp->blockCacheStats().miss, stats.miss);
 
     auto fakeBlock3 = std::make_shared<FakeBlock>(15);
     fakeBlock3->getBlock().header().setNumber(m_blockChainImp->number() + 1);
@@ -197,6 +197,33 @@ BOOST_AUTO_TEST_CASE(testPBFTMsgPacket)
     BOOST_CHECK(tmp_packet != packet);
     BOOST_CHECK(tmp_packet.timestamp >= packet.timestamp);
 }
+
+/// test MissedTxsReq and MissedTxsResp
+BOOST_AUTO_TEST_CASE(testMissedTxs)
+{
+    MissedTxsReq req;
+    req.block_hash = sha3("block");
+    req.indexes = {0, 3, 1024};
+    bytes req_data;
+    BOOST_REQUIRE_NO_THROW(req.encode(req_data));
+    MissedTxsReq tmp_req;
+    BOOST_REQUIRE_NO_THROW(tmp_req.decode(ref(req_data)));
+    BOOST_CHECK(tmp_req.block_hash == req.block_hash);
+    BOOST_CHECK(tmp_req.indexes == req.indexes);
+
+    MissedTxsResp resp;
+    resp.block_hash = req.block_hash;
+    resp.txs = {rlp("tx0"), rlp("tx3")};
+    bytes resp_data;
+    BOOST_REQUIRE_NO_THROW(resp.encode(resp_data));
+    MissedTxsResp tmp_resp;
+    BOOST_REQUIRE_NO_THROW(tmp_resp.decode(ref(resp_data)));
+    BOOST_CHECK(tmp_resp.block_hash == resp.block_hash);
+    BOOST_CHECK(tmp_resp.txs == resp.txs);
+    /// test decode exception
+    resp_data[0] += 1;
+    BOOST_CHECK_THROW(tmp_resp.decode(ref(resp_data)), std::exception);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -171,6 +171,51 @@ public:
         return PBFTEngine::handleCommitMsg(commit_req, pbftMsg);
     }
 
+    void handleCompactPrepareMsg(PrepareReq& prepareReq, PBFTMsgPacket const& pbftMsg)
+    {
+        return PBFTEngine::handleCompactPrepareMsg(prepareReq, pbftMsg);
+    }
+    void completeCompactPrepare(PrepareReq& prepareReq, BlockHeader const& header,
+        Transactions const& txs, std::string const& endpoint = "self")
+    {
+        return PBFTEngine::completeCompactPrepare(prepareReq, header, txs, endpoint);
+    }
+    void handleMissedTxsReq(PBFTMsgPacket const& pbftMsg)
+    {
+        return PBFTEngine::handleMissedTxsReq(pbftMsg);
+    }
+    void handleMissedTxsResp(PBFTMsgPacket const& pbftMsg)
+    {
+        return PBFTEngine::handleMissedTxsResp(pbftMsg);
+    }
+    static bytes encodeCompactBlock(Block const& block)
+    {
+        return PBFTEngine::encodeCompactBlock(block);
+    }
+    std::shared_ptr<PartialPrepare> partialPrepare() { return m_partialPrepare; }
+    std::shared_ptr<PartialPrepare> futureCompactPrepare() { return m_futureCompactPrepare; }
+
+    bool checkSign(PBFTMsg const& req) const { return PBFTEngine::checkSign(req); }
+    void preVerifySign(PBFTMsgPacket const& _packet) { PBFTEngine::preVerifySign(_packet); }
+    void addVerifiedSign(h256 const& _key) { PBFTEngine::addVerifiedSign(_key); }
+    static h256 signKey(h512 const& _nodeId, PBFTMsg const& _req)
+    {
+        return PBFTEngine::signKey(_nodeId, _req);
+    }
+    bool checkSigList(Block const& block) { return PBFTEngine::checkSigList(block); }
+    size_t verifiedSignsSize() const
+    {
+        ReadGuard l(x_verifiedSigns);
+        return m_verifiedSigns.size();
+    }
+    bool isSignVerified(h256 const& _key) const
+    {
+        ReadGuard l(x_verifiedSigns);
+        return m_verifiedSigns.count(_key);
+    }
+    static size_t maxVerifiedSigns() { return c_maxVerifiedSigns; }
+    std::shared_ptr<dev::ThreadPool> verifyPool() { return m_verifyPool; }
+
     bool shouldSeal() { return PBFTEngine::shouldSeal(); }
 
     void setNodeIdx(IDXTYPE const& _idx) { m_idx = _idx; }
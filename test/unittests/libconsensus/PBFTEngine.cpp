@@ -26,6 +26,9 @@
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <future>
+#include <thread>
 namespace dev
 {
 namespace test
@@ -645,6 +648,322 @@ BOOST_AUTO_TEST_CASE(testHandleFutureBlock)
     BOOST_CHECK(fake_pbft.consensus()->reqCache()->futurePrepareCache().block_hash == h256());
 }
 
+/// test handleCompactPrepareMsg, handleMissedTxsResp and completeCompactPrepare
+BOOST_AUTO_TEST_CASE(testHandleCompactPrepare)
+{
+    FakeConsensus<FakePBFTEngine> fake_pbft(1, ProtocolID::PBFT);
+    fake_pbft.consensus()->initPBFTEnv(
+        3 * (fake_pbft.consensus()->timeManager().m_intervalBlockTime));
+    PrepareReq req;
+    PrepareReq compactReq;
+    Transactions txs;
+    fakeValidCompactPrepare(fake_pbft, req, compactReq, txs);
+    FakeService* fake_service =
+        dynamic_cast<FakeService*>(fake_pbft.consensus()->mutableService().get());
+    fake_service->setConnected();
+    h512 leader = fake_pbft.m_minerList[req.idx];
+    PBFTMsgPacket packet;
+
+    /// a compact prepare with an invalid signature is dropped before asking for transactions
+    PrepareReq invalidReq = compactReq;
+    invalidReq.sig2 = dev::sign(KeyPair::create().secret(), invalidReq.fieldsWithoutBlock());
+    FakePBFTMsgPacket(packet, invalidReq, CompactPrepareReqPacket, req.idx, leader);
+    fake_pbft.consensus()->handleCompactPrepareMsg(invalidReq, packet);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() == nullptr);
+    compareAsyncSendTime(fake_pbft, leader, 0);
+
+    /// so is a compact prepare from a node which isn't the leader
+    invalidReq = compactReq;
+    invalidReq.idx = (req.idx + 1) % fake_pbft.consensus()->nodeNum();
+    FakePBFTMsgPacket(packet, invalidReq, CompactPrepareReqPacket, invalidReq.idx, leader);
+    fake_pbft.consensus()->handleCompactPrepareMsg(invalidReq, packet);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() == nullptr);
+    compareAsyncSendTime(fake_pbft, leader, 0);
+
+    /// the txpool has none of the transactions, the full prepare is requested from the leader
+    PrepareReq recvReq;
+    FakePBFTMsgPacket(packet, compactReq, CompactPrepareReqPacket, req.idx, leader);
+    fake_pbft.consensus()->handleCompactPrepareMsg(recvReq, packet);
+    BOOST_REQUIRE(fake_pbft.consensus()->partialPrepare() != nullptr);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare()->missed.size() == txs.size());
+    compareAsyncSendTime(fake_pbft, leader, 1);
+
+    /// a response for another block or with missing transactions is ignored
+    MissedTxsResp resp;
+    resp.block_hash = sha3("invalid");
+    for (auto const& tx : txs)
+        resp.txs.push_back(tx.rlp());
+    FakePBFTMsgPacket(packet, resp, MissedTxsRespPacket, req.idx, leader);
+    fake_pbft.consensus()->handleMissedTxsResp(packet);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() != nullptr);
+    resp.block_hash = req.block_hash;
+    resp.txs.pop_back();
+    FakePBFTMsgPacket(packet, resp, MissedTxsRespPacket, req.idx, leader);
+    fake_pbft.consensus()->handleMissedTxsResp(packet);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() != nullptr);
+
+    /// the missed transactions complete the block, which is handled as a full prepare
+    resp.txs.push_back(txs.back().rlp());
+    FakePBFTMsgPacket(packet, resp, MissedTxsRespPacket, req.idx, leader);
+    fake_pbft.consensus()->handleMissedTxsResp(packet);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() == nullptr);
+    BOOST_CHECK(fake_pbft.consensus()->reqCache()->rawPrepareCache().block_hash == req.block_hash);
+    BOOST_CHECK(fake_pbft.consensus()->reqCache()->rawPrepareCache().block == req.block);
+
+    /// a rebuilt block whose transactions differ from the sealed ones is dropped
+    fake_pbft.consensus()->reqCache()->clearAll();
+    Block block;
+    block.decode(ref(req.block));
+    Transactions otherTxs(txs.rbegin(), txs.rend());
+    PrepareReq otherReq = compactReq;
+    fake_pbft.consensus()->completeCompactPrepare(otherReq, block.header(), otherTxs);
+    BOOST_CHECK(fake_pbft.consensus()->reqCache()->rawPrepareCache().block_hash != req.block_hash);
+    otherReq = compactReq;
+    fake_pbft.consensus()->completeCompactPrepare(otherReq, block.header(), txs);
+    BOOST_CHECK(fake_pbft.consensus()->reqCache()->rawPrepareCache().block_hash == req.block_hash);
+}
+
+/// test handleMissedTxsReq
+BOOST_AUTO_TEST_CASE(testHandleMissedTxsReq)
+{
+    FakeConsensus<FakePBFTEngine> fake_pbft(1, ProtocolID::PBFT);
+    PrepareReq req;
+    PrepareReq compactReq;
+    Transactions txs;
+    fakeValidCompactPrepare(fake_pbft, req, compactReq, txs);
+    FakeService* fake_service =
+        dynamic_cast<FakeService*>(fake_pbft.consensus()->mutableService().get());
+    fake_service->setConnected();
+    KeyPair peer = KeyPair::create();
+    PBFTMsgPacket packet;
+    MissedTxsReq missedReq;
+    missedReq.block_hash = req.block_hash;
+    missedReq.indexes = {0, uint32_t(txs.size() - 1)};
+
+    /// the prepare is unknown
+    FakePBFTMsgPacket(packet, missedReq, MissedTxsReqPacket, 0, peer.pub());
+    fake_pbft.consensus()->handleMissedTxsReq(packet);
+    compareAsyncSendTime(fake_pbft, peer.pub(), 0);
+
+    /// the missed transactions of the prepare being handled
+    fake_pbft.consensus()->reqCache()->addRawPrepare(req);
+    fake_pbft.consensus()->handleMissedTxsReq(packet);
+    compareAsyncSendTime(fake_pbft, peer.pub(), 1);
+
+    /// an index out of the block is answered with nothing
+    missedReq.indexes = {uint32_t(txs.size())};
+    FakePBFTMsgPacket(packet, missedReq, MissedTxsReqPacket, 0, peer.pub());
+    fake_pbft.consensus()->handleMissedTxsReq(packet);
+    compareAsyncSendTime(fake_pbft, peer.pub(), 1);
+
+    /// no index asks for the full prepare
+    missedReq.indexes.clear();
+    FakePBFTMsgPacket(packet, missedReq, MissedTxsReqPacket, 0, peer.pub());
+    fake_pbft.consensus()->handleMissedTxsReq(packet);
+    compareAsyncSendTime(fake_pbft, peer.pub(), 2);
+}
+
+/// test a compact prepare received while the previous block is being committed
+BOOST_AUTO_TEST_CASE(testFutureCompactPrepare)
+{
+    FakeConsensus<FakePBFTEngine> fake_pbft(1, ProtocolID::PBFT);
+    fake_pbft.consensus()->initPBFTEnv(
+        3 * (fake_pbft.consensus()->timeManager().m_intervalBlockTime));
+    PrepareReq req;
+    PrepareReq compactReq;
+    Transactions txs;
+    fakeValidCompactPrepare(fake_pbft, req, compactReq, txs);
+    FakeService* fake_service =
+        dynamic_cast<FakeService*>(fake_pbft.consensus()->mutableService().get());
+    fake_service->setConnected();
+    h512 leader = fake_pbft.m_minerList[req.idx];
+    PBFTMsgPacket packet;
+
+    /// the node is still at N-1, the compact prepare of N is kept without requesting anything
+    fake_pbft.consensus()->mutableConsensusNumber() = req.height - 1;
+    PrepareReq recvReq;
+    FakePBFTMsgPacket(packet, compactReq, CompactPrepareReqPacket, req.idx, leader);
+    fake_pbft.consensus()->handleCompactPrepareMsg(recvReq, packet);
+    BOOST_REQUIRE(fake_pbft.consensus()->futureCompactPrepare() != nullptr);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() == nullptr);
+    fake_pbft.consensus()->handleFutureBlock();
+    BOOST_CHECK(fake_pbft.consensus()->futureCompactPrepare() != nullptr);
+    compareAsyncSendTime(fake_pbft, leader, 0);
+
+    /// N-1 is committed, the block is rebuilt and the missed transactions are requested
+    fake_pbft.consensus()->mutableConsensusNumber() = req.height;
+    fake_pbft.consensus()->handleFutureBlock();
+    BOOST_CHECK(fake_pbft.consensus()->futureCompactPrepare() == nullptr);
+    BOOST_REQUIRE(fake_pbft.consensus()->partialPrepare() != nullptr);
+    compareAsyncSendTime(fake_pbft, leader, 1);
+
+    /// the response completes N
+    MissedTxsResp resp;
+    resp.block_hash = req.block_hash;
+    for (auto const& tx : txs)
+        resp.txs.push_back(tx.rlp());
+    FakePBFTMsgPacket(packet, resp, MissedTxsRespPacket, req.idx, leader);
+    fake_pbft.consensus()->handleMissedTxsResp(packet);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() == nullptr);
+    BOOST_CHECK(fake_pbft.consensus()->reqCache()->rawPrepareCache().block_hash == req.block_hash);
+
+    /// a compact prepare older than the consensus number is dropped
+    fake_pbft.consensus()->reqCache()->clearAll();
+    fake_pbft.consensus()->mutableConsensusNumber() = req.height - 1;
+    FakePBFTMsgPacket(packet, compactReq, CompactPrepareReqPacket, req.idx, leader);
+    fake_pbft.consensus()->handleCompactPrepareMsg(recvReq, packet);
+    BOOST_REQUIRE(fake_pbft.consensus()->futureCompactPrepare() != nullptr);
+    fake_pbft.consensus()->mutableConsensusNumber() = req.height + 1;
+    fake_pbft.consensus()->handleFutureBlock();
+    BOOST_CHECK(fake_pbft.consensus()->futureCompactPrepare() == nullptr);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() == nullptr);
+    compareAsyncSendTime(fake_pbft, leader, 1);
+}
+
+/// test the missed transactions are requested again, and the partial prepare expires
+BOOST_AUTO_TEST_CASE(testPartialPrepareExpiry)
+{
+    FakeConsensus<FakePBFTEngine> fake_pbft(1, ProtocolID::PBFT);
+    fake_pbft.consensus()->initPBFTEnv(
+        3 * (fake_pbft.consensus()->timeManager().m_intervalBlockTime));
+    PrepareReq req;
+    PrepareReq compactReq;
+    Transactions txs;
+    fakeValidCompactPrepare(fake_pbft, req, compactReq, txs);
+    FakeService* fake_service =
+        dynamic_cast<FakeService*>(fake_pbft.consensus()->mutableService().get());
+    fake_service->setConnected();
+    h512 leader = fake_pbft.m_minerList[req.idx];
+    PBFTMsgPacket packet;
+    PrepareReq recvReq;
+    FakePBFTMsgPacket(packet, compactReq, CompactPrepareReqPacket, req.idx, leader);
+    fake_pbft.consensus()->handleCompactPrepareMsg(recvReq, packet);
+    BOOST_REQUIRE(fake_pbft.consensus()->partialPrepare() != nullptr);
+    compareAsyncSendTime(fake_pbft, leader, 1);
+
+    /// the same prepare doesn't request again, the retry interval does
+    fake_pbft.consensus()->mutableTimeManager().m_lastConsensusTime = utcTime();
+    fake_pbft.consensus()->handleCompactPrepareMsg(recvReq, packet);
+    fake_pbft.consensus()->checkTimeout();
+    compareAsyncSendTime(fake_pbft, leader, 1);
+    fake_pbft.consensus()->partialPrepare()->requestTime = 0;
+    fake_pbft.consensus()->checkTimeout();
+    compareAsyncSendTime(fake_pbft, leader, 2);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() != nullptr);
+
+    /// a reported block drops it
+    Block block;
+    block.decode(ref(req.block));
+    fake_pbft.consensus()->reportBlock(block);
+    BOOST_CHECK(fake_pbft.consensus()->partialPrepare() == nullptr);
+}
+
+/// test preVerifySign and the verified signatures checkSign relies on
+BOOST_AUTO_TEST_CASE(testPreVerifySign)
+{
+    FakeConsensus<FakePBFTEngine> fake_pbft(2, ProtocolID::PBFT);
+    PrepareReq req;
+    fakeValidPrepare(fake_pbft, req);
+    h512 signer = fake_pbft.m_minerList[req.idx];
+    PBFTMsgPacket packet;
+
+    /// a signature of another node isn't recorded
+    PrepareReq invalidReq = req;
+    invalidReq.sig2 = dev::sign(KeyPair::create().secret(), invalidReq.fieldsWithoutBlock());
+    FakePBFTMsgPacket(packet, invalidReq, PrepareReqPacket, req.idx, signer);
+    fake_pbft.consensus()->preVerifySign(packet);
+    BOOST_CHECK(fake_pbft.consensus()->verifiedSignsSize() == 0);
+    BOOST_CHECK(fake_pbft.consensus()->checkSign(invalidReq) == false);
+
+    /// a malformed packet is left to the workLoop
+    packet.data = bytes{1, 2, 3};
+    fake_pbft.consensus()->preVerifySign(packet);
+    BOOST_CHECK(fake_pbft.consensus()->verifiedSignsSize() == 0);
+
+    /// a valid signature is recorded and found by checkSign
+    FakePBFTMsgPacket(packet, req, PrepareReqPacket, req.idx, signer);
+    fake_pbft.consensus()->preVerifySign(packet);
+    BOOST_CHECK(fake_pbft.consensus()->verifiedSignsSize() == 1);
+    BOOST_CHECK(fake_pbft.consensus()->isSignVerified(FakePBFTEngine::signKey(signer, req)));
+    BOOST_CHECK(fake_pbft.consensus()->checkSign(req));
+
+    /// the record binds the signed fields, it doesn't pass another request of the signer
+    PrepareReq otherReq = req;
+    otherReq.view += 1;
+    BOOST_CHECK(!fake_pbft.consensus()->isSignVerified(FakePBFTEngine::signKey(signer, otherReq)));
+    BOOST_CHECK(fake_pbft.consensus()->checkSign(otherReq) == false);
+
+    /// a received message is queued and verified on the verify pool
+    IDXTYPE peerIdx = (fake_pbft.consensus()->nodeIdx() + 1) % fake_pbft.consensus()->nodeNum();
+    SignReq signReq(req, KeyPair(fake_pbft.m_secrets[peerIdx]), peerIdx);
+    h256 key = FakePBFTEngine::signKey(fake_pbft.m_minerList[peerIdx], signReq);
+    CheckOnRecvPBFTMessage(fake_pbft.consensus(),
+        FakeSessionFunc(fake_pbft.m_minerList[peerIdx]), signReq, SignReqPacket, true);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!fake_pbft.consensus()->isSignVerified(key) &&
+           std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    BOOST_CHECK(fake_pbft.consensus()->isSignVerified(key));
+    BOOST_CHECK(fake_pbft.consensus()->checkSign(signReq));
+}
+
+/// test the bound of the verified signatures
+BOOST_AUTO_TEST_CASE(testVerifiedSignsLimit)
+{
+    FakeConsensus<FakePBFTEngine> fake_pbft(1, ProtocolID::PBFT);
+    unsigned limit = FakePBFTEngine::maxVerifiedSigns();
+    for (unsigned i = 0; i < limit; ++i)
+        fake_pbft.consensus()->addVerifiedSign(h256(i));
+    BOOST_CHECK(fake_pbft.consensus()->verifiedSignsSize() == limit);
+    BOOST_CHECK(fake_pbft.consensus()->isSignVerified(h256(0u)));
+
+    /// the records are dropped when the bound is reached, then the new one is added
+    fake_pbft.consensus()->addVerifiedSign(h256(limit));
+    BOOST_CHECK(fake_pbft.consensus()->verifiedSignsSize() == 1);
+    BOOST_CHECK(!fake_pbft.consensus()->isSignVerified(h256(0u)));
+    BOOST_CHECK(fake_pbft.consensus()->isSignVerified(h256(limit)));
+}
+
+/// test checkSigList
+BOOST_AUTO_TEST_CASE(testCheckSigList)
+{
+    FakeConsensus<FakePBFTEngine> fake_pbft(4, ProtocolID::PBFT);
+    /// the pool sizes configured by consensus.verifyThreads
+    const size_t verifyThreads = 2;
+    fake_pbft.consensus()->setVerifyThreads(verifyThreads);
+    FakeBlockChain* p_blockChain =
+        dynamic_cast<FakeBlockChain*>(fake_pbft.consensus()->blockChain().get());
+    Block block = *p_blockChain->getBlockByNumber(p_blockChain->number());
+    h256 block_hash = block.blockHeader().hash();
+    std::vector<std::pair<u256, Signature>> sig_list;
+    for (size_t i = 0; i < fake_pbft.m_minerList.size(); ++i)
+        sig_list.push_back(std::make_pair(u256(i), dev::sign(fake_pbft.m_secrets[i], block_hash)));
+    block.setSigList(sig_list);
+    BOOST_CHECK(fake_pbft.consensus()->checkSigList(block));
+
+    /// the seals are checked while every worker of the message verify pool is busy
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    for (size_t i = 0; i < verifyThreads; ++i)
+        fake_pbft.consensus()->verifyPool()->enqueue([released]() { released.wait(); });
+    auto checked = std::async(
+        std::launch::async, [&]() { return fake_pbft.consensus()->checkSigList(block); });
+    BOOST_CHECK(checked.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    release.set_value();
+    BOOST_CHECK(checked.get());
+
+    /// a seal signed by another node
+    sig_list[1].second = dev::sign(KeyPair::create().secret(), block_hash);
+    block.setSigList(sig_list);
+    BOOST_CHECK(fake_pbft.consensus()->checkSigList(block) == false);
+
+    /// a seal of an index out of the miner list
+    sig_list[1] = std::make_pair(
+        u256(fake_pbft.m_minerList.size()), dev::sign(fake_pbft.m_secrets[1], block_hash));
+    block.setSigList(sig_list);
+    BOOST_CHECK(fake_pbft.consensus()->checkSigList(block) == false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
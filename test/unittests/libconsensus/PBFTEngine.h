@@ -419,6 +419,27 @@ static void fakeValidPrepare(FakeConsensus<FakePBFTEngine>& fake_pbft, PrepareRe
     req.sig2 = dev::sign(sec, req.fieldsWithoutBlock());
 }
 
+/// fake a valid prepare of a block with transactions and the compact prepare of the block
+static void fakeValidCompactPrepare(FakeConsensus<FakePBFTEngine>& fake_pbft, PrepareReq& req,
+    PrepareReq& compactReq, Transactions& txs)
+{
+    fakeValidPrepare(fake_pbft, req);
+    FakeBlockChain* p_blockChain =
+        dynamic_cast<FakeBlockChain*>(fake_pbft.consensus()->blockChain().get());
+    txs = p_blockChain->getBlockByNumber(0)->transactions();
+    Block block;
+    block.decode(ref(req.block));
+    block.setTransactions(txs);
+    block.calTransactionRoot();
+    block.encode(req.block);
+    req.block_hash = block.header().hash();
+    Secret sec = fake_pbft.m_secrets[req.idx];
+    req.sig = dev::sign(sec, req.block_hash);
+    req.sig2 = dev::sign(sec, req.fieldsWithoutBlock());
+    compactReq = req;
+    compactReq.block = FakePBFTEngine::encodeCompactBlock(block);
+}
+
 /// test isValidPrepare
 static void TestIsValidPrepare(FakeConsensus<FakePBFTEngine>& fake_pbft, PrepareReq& req, bool succ)
 {
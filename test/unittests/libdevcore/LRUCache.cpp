@@ -0,0 +1,82 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief Unit tests for the memory bounded LRUCache
+ *
+ * @file LRUCache.cpp
+ * @author agent
+ * @date 2026-10-18
+ */
+
+#include <libdevcore/LRUCache.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <string>
+
+using namespace dev;
+
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(LRUCacheTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(getAndReplace)
+{
+    LRUCache<std::string, int> cache(100);
+    BOOST_CHECK(cache.get("a") == nullptr);
+    cache.put("a", 1, 10);
+    BOOST_REQUIRE(cache.get("a") != nullptr);
+    BOOST_CHECK_EQUAL(*cache.get("a"), 1);
+    cache.put("a", 2, 20);
+    BOOST_CHECK_EQUAL(*cache.get("a"), 2);
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+    BOOST_CHECK_EQUAL(cache.memory(), 20u);
+
+    cache.erase("a");
+    BOOST_CHECK(cache.get("a") == nullptr);
+    BOOST_CHECK_EQUAL(cache.memory(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(eviction)
+{
+    LRUCache<int, int> cache(30);
+    cache.put(1, 1, 10);
+    cache.put(2, 2, 10);
+    cache.put(3, 3, 10);
+    // 1 becomes the most recently used, 2 is evicted
+    cache.get(1);
+    cache.put(4, 4, 10);
+    BOOST_CHECK(cache.get(2) == nullptr);
+    BOOST_CHECK(cache.get(1) != nullptr);
+    BOOST_CHECK(cache.get(3) != nullptr);
+    BOOST_CHECK(cache.get(4) != nullptr);
+    BOOST_CHECK_EQUAL(cache.memory(), 30u);
+
+    // a value larger than the capacity is not cached and drops the old one
+    cache.put(1, 5, 31);
+    BOOST_CHECK(cache.get(1) == nullptr);
+    BOOST_CHECK_EQUAL(cache.size(), 2u);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+    BOOST_CHECK_EQUAL(cache.memory(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
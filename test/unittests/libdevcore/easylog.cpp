@@ -0,0 +1,157 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief Unit tests for the LOG() front end and the asynchronous writer
+ *
+ * @file easylog.cpp
+ * @author agent
+ * @date 2026-10-18
+ */
+
+#include <libdevcore/easylog.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <thread>
+
+using namespace dev;
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+static const char* c_logFile = "/tmp/logs/easylog.test.log";
+
+class EasylogFixture : TestOutputHelperFixture
+{
+public:
+    EasylogFixture()
+    {
+        auto logger = el::Loggers::getLogger("default");
+        m_configurations = *logger->configurations();
+        remove(c_logFile);
+        el::Configurations c;
+        c.setGlobally(el::ConfigurationType::Format, "%level %msg");
+        c.setGlobally(el::ConfigurationType::Filename, c_logFile);
+        c.setGlobally(el::ConfigurationType::ToFile, "true");
+        c.setGlobally(el::ConfigurationType::ToStandardOutput, "false");
+        c.set(el::Level::Debug, el::ConfigurationType::Enabled, "false");
+        el::Loggers::reconfigureLogger(logger, c);
+        refreshLogLevels();
+    }
+    ~EasylogFixture()
+    {
+        AsyncLogWriter::stop();
+        el::Loggers::reconfigureLogger("default", m_configurations);
+        refreshLogLevels();
+    }
+
+    std::vector<std::string> lines()
+    {
+        el::Loggers::getLogger("default")->flush();
+        std::ifstream file(c_logFile);
+        std::vector<std::string> ret;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            ret.push_back(line);
+        }
+        return ret;
+    }
+
+private:
+    el::Configurations m_configurations;
+};
+
+BOOST_FIXTURE_TEST_SUITE(easylog, EasylogFixture)
+
+BOOST_AUTO_TEST_CASE(lazyArguments)
+{
+    int evaluated = 0;
+    auto argument = [&]() { return ++evaluated; };
+    BOOST_CHECK(!logEnabled(el::Level::Debug));
+    LOG(DEBUG) << argument();
+    BOOST_CHECK_EQUAL(evaluated, 0);
+    LOG(INFO) << argument();
+    BOOST_CHECK_EQUAL(evaluated, 1);
+
+    auto content = lines();
+    BOOST_REQUIRE_EQUAL(content.size(), 1u);
+    BOOST_CHECK_EQUAL(content[0], "INFO 1");
+}
+
+BOOST_AUTO_TEST_CASE(formatIsPerRecord)
+{
+    LOG(INFO) << std::hex << 255;
+    LOG(INFO) << 255;
+    auto content = lines();
+    BOOST_REQUIRE_EQUAL(content.size(), 2u);
+    BOOST_CHECK_EQUAL(content[0], "INFO ff");
+    BOOST_CHECK_EQUAL(content[1], "INFO 255");
+}
+
+BOOST_AUTO_TEST_CASE(asyncWriter)
+{
+    AsyncLogWriter::start();
+    BOOST_CHECK(AsyncLogWriter::running());
+    // more records than a ring holds, so that the threads wait for the writer
+    const int threads = 4;
+    const int records = 5000;
+    std::vector<std::thread> loggers;
+    for (int i = 0; i < threads; ++i)
+    {
+        loggers.emplace_back([i]() {
+            for (int j = 0; j < records; ++j)
+            {
+                LOG(INFO) << i << " " << j;
+                LOG(DEBUG) << "filtered";
+            }
+        });
+    }
+    for (auto& t : loggers)
+    {
+        t.join();
+    }
+    AsyncLogWriter::flush();
+
+    auto content = lines();
+    BOOST_REQUIRE_EQUAL(content.size(), size_t(threads * records));
+    // the records of a thread keep their order
+    std::vector<int> next(threads, 0);
+    for (auto const& line : content)
+    {
+        std::istringstream in(line);
+        std::string level;
+        int i, j;
+        in >> level >> i >> j;
+        BOOST_REQUIRE_EQUAL(level, "INFO");
+        BOOST_REQUIRE(i >= 0 && i < threads);
+        BOOST_REQUIRE_EQUAL(j, next[i]);
+        ++next[i];
+    }
+
+    AsyncLogWriter::stop();
+    BOOST_CHECK(!AsyncLogWriter::running());
+    LOG(INFO) << "sync";
+    content = lines();
+    BOOST_CHECK_EQUAL(content.back(), "INFO sync");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
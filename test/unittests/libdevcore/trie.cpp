@@ -19,6 +19,7 @@
 #include <json_spirit/JsonSpiritHeaders.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/MemoryDB.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/TrieDB.h>
 #include <libdevcore/TrieHash.h>
 #include <libdevcore/easylog.h>
@@ -712,5 +713,23 @@ BOOST_AUTO_TEST_CASE(triePerf)
         clog << "Skipping hive test Crypto/Trie/triePerf. Use --all to run it.\n";
 }
 
+BOOST_AUTO_TEST_CASE(parallelHash256)
+{
+    ThreadPool pool("TrieTest", 4);
+    for (size_t count : {0, 1, 255, 256, 1000, 5000})
+    {
+        BytesMap ordered;
+        BytesMap hashed;
+        for (size_t i = 0; i < count; ++i)
+        {
+            ordered[rlp(i)] = bytes(i % 97 + 1, (byte)i);
+            hashed[sha3(rlp(i)).asBytes()] = rlp(i);
+        }
+        BOOST_CHECK_EQUAL(hash256(ordered, pool, 4), hash256(ordered));
+        BOOST_CHECK_EQUAL(hash256(ordered, pool, 3), hash256(ordered));
+        BOOST_CHECK_EQUAL(hash256(hashed, pool, 4), hash256(hashed));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,8 @@
 #include <libdevcore/FixedHash.h>
 #include <libdevcrypto/Common.h>
 #include <libethcore/EVMSchedule.h>
+#include <libinterpreter/AnalysedCodeCache.h>
+#include <libinterpreter/Arith256.h>
 #include <libinterpreter/interpreter.h>
 #include <test/tools/libutils/FakeEvmc.h>
 #include <test/tools/libutils/TestOutputHelper.h>
@@ -1229,6 +1231,101 @@ BOOST_AUTO_TEST_CASE(errorCodeTest)
     BOOST_CHECK(result.status_code == EVMC_BAD_JUMP_DESTINATION);
 }
 
+BOOST_AUTO_TEST_CASE(analysedCodeCacheTest)
+{
+    // PUSH32 1122...ff00 (stored in the constant pool)
+    // PUSH1 00
+    // MSTORE
+    // PUSH1 20 PUSH1 00
+    // RETURN
+    dev::eth::EVMSchedule const& schedule = DefaultSchedule;
+    bytes code = fromHex(
+        "7f112233445566778899aabbccddeeff00112233445566778899aabbccddeeff00"
+        "60005260206000f3");
+    bytes data = fromHex("");
+    Address destination{KeyPair::create().address()};
+    Address caller = destination;
+    u256 value = 0;
+    int64_t gas = 1000000;
+    int32_t depth = 0;
+    bool isCreate = false;
+    bool isStaticCall = false;
+    u256 expected("0x112233445566778899aabbccddeeff00112233445566778899aabbccddeeff00");
+
+    auto& cache = dev::eth::AnalysedCodeCache::instance();
+    auto before = cache.stats();
+    for (int i = 0; i < 2; ++i)
+    {
+        evmc_result result = evmc.execute(
+            schedule, code, data, destination, caller, value, gas, depth, isCreate, isStaticCall);
+        BOOST_CHECK(0 == result.status_code);
+        u256 r = 0;
+        for (size_t j = 0; j < 32; j++)
+            r = (r << 8) | result.output_data[j];
+        BOOST_CHECK(expected == r);
+    }
+    // the second call reuses the analysis of the first one
+    auto after = cache.stats();
+    BOOST_CHECK_EQUAL(after.miss, before.miss + 1);
+    BOOST_CHECK_EQUAL(after.hit, before.hit + 1);
+    BOOST_CHECK(after.memory <= after.capacity);
+
+    // init code is never cached
+    before = after;
+    evmc_result result = evmc.execute(
+        schedule, code, data, destination, caller, value, gas, depth, true, isStaticCall);
+    BOOST_CHECK(0 == result.status_code);
+    after = cache.stats();
+    BOOST_CHECK_EQUAL(after.miss, before.miss);
+    BOOST_CHECK_EQUAL(after.hit, before.hit);
+}
+BOOST_AUTO_TEST_CASE(arith256Test)
+{
+    // carry chains across every limb, sign bits and single limb values
+    u256 const max = ~u256(0);
+    std::vector<u256> values{0, 1, 2, 0xffffffffffffffff, u256(1) << 64, (u256(1) << 128) - 1,
+        u256(1) << 255, max, max - 1, u256("0x1234567890abcdef1234567890abcdef1234567890abcdef"),
+        u256("0xfedcba0987654321fedcba0987654321fedcba0987654321fedcba0987654321")};
+    for (auto const& a : values)
+    {
+        for (auto const& b : values)
+        {
+            u256 r;
+            dev::eth::arith256::add(r, a, b);
+            BOOST_CHECK(r == u256(a + b));
+            dev::eth::arith256::sub(r, a, b);
+            BOOST_CHECK(r == u256(a - b));
+            dev::eth::arith256::mul(r, a, b);
+            BOOST_CHECK(r == u256(a * b));
+            BOOST_CHECK(dev::eth::arith256::slt(a, b) == (u2s(a) < u2s(b)));
+
+            // the result may alias an operand, as m_SPP[0] and m_SP[1] do
+            r = b;
+            dev::eth::arith256::add(r, a, r);
+            BOOST_CHECK(r == u256(a + b));
+        }
+        for (unsigned shift : {0u, 1u, 63u, 64u, 65u, 128u, 200u, 255u})
+        {
+            u256 r;
+            dev::eth::arith256::shl(r, a, shift);
+            BOOST_CHECK(r == u256(a << shift));
+        }
+        for (u256 exponent : {u256(0), u256(1), u256(2), u256(255), u256(256), max})
+        {
+            u256 expected = 1;
+            u256 base = a;
+            for (u256 e = exponent; e; e >>= 1)
+            {
+                if (e & 1)
+                    expected *= base;
+                base *= base;
+            }
+            u256 r;
+            dev::eth::arith256::exp(r, a, exponent);
+            BOOST_CHECK(r == expected);
+        }
+    }
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -47,6 +47,63 @@ BOOST_AUTO_TEST_CASE(LoadAccountCode)
     BOOST_CHECK(std::equal(std::begin(codeData), std::end(codeData), std::begin(loadedCode)));
 }
 
+BOOST_AUTO_TEST_CASE(CommitTransaction)
+{
+    Address a{"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+    Address b{"bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"};
+    Address c{"cccccccccccccccccccccccccccccccccccccccc"};
+    auto execute = [&](State& s, std::function<void()> const& finishTransaction) {
+        s.addBalance(a, 100);
+        s.createContract(c);
+        s.setCode(c, bytes{'c', 'o', 'd', 'e'});
+        s.setStorage(c, 1, 5);
+        finishTransaction();
+
+        BOOST_CHECK_EQUAL(s.storage(c, 1), 5);
+        BOOST_CHECK_EQUAL(s.balance(a), 100);
+        // reverted transaction, must not undo the previous one
+        size_t savepoint = s.savepoint();
+        s.addBalance(a, 10);
+        s.addBalance(b, 10);
+        s.setStorage(c, 1, 6);
+        s.rollback(savepoint);
+        s.addBalance(a, 1);
+        finishTransaction();
+
+        BOOST_CHECK(s.addressInUse(c));
+        BOOST_CHECK(!s.addressInUse(b));
+        s.kill(c);
+        finishTransaction();
+
+        BOOST_CHECK(!s.addressInUse(c));
+        s.createContract(c);
+        s.setCode(c, bytes{'n', 'e', 'w'});
+        s.setStorage(c, 2, 7);
+        BOOST_CHECK_EQUAL(s.storage(c, 1), 0);
+        // emptied account is removed
+        s.subBalance(a, 101);
+        finishTransaction();
+
+        BOOST_CHECK(!s.addressInUse(a));
+        BOOST_CHECK_EQUAL(s.storage(c, 2), 7);
+    };
+
+    State perTransaction{0};
+    execute(perTransaction, [&]() { perTransaction.commit(); });
+
+    State perBlock{0};
+    h256 parentRoot = perBlock.rootHash();
+    execute(perBlock, [&]() {
+        perBlock.commitTransaction();
+        BOOST_CHECK_EQUAL(perBlock.rootHash(), parentRoot);
+    });
+    perBlock.commit();
+
+    BOOST_CHECK_EQUAL(perBlock.rootHash(), perTransaction.rootHash());
+    BOOST_CHECK(perBlock.rootHash() != parentRoot);
+    BOOST_CHECK_EQUAL(perBlock.storage(c, 2), 7);
+}
+
 class AddressRangeTestFixture : public TestOutputHelperFixture
 {
 public:
@@ -143,6 +143,8 @@ public:
     virtual ~MockBlockChain() {}
 
     virtual int64_t number() override { return m_blockNumber; }
+    /// the highest block is still being persisted when m_persisting is set
+    int64_t durableNumber() override { return m_persisting ? number() - 1 : number(); }
     virtual std::pair<int64_t, int64_t> totalTransactionCount() override
     {
         return std::make_pair(m_totalTransactionCount, m_blockNumber);
@@ -257,6 +259,7 @@ public:
     std::vector<std::shared_ptr<Block>> m_blockChain;
     uint64_t m_blockNumber;
     uint64_t m_totalTransactionCount;
+    bool m_persisting = false;
 
     GenesisBlockParam m_initParam;
 };
@@ -613,6 +613,33 @@ BOOST_AUTO_TEST_CASE(testGetTransactionReceipt)
 
     BOOST_CHECK_THROW(rpc->getTransactionReceipt(invalidGroup, txHash), JsonRpcException);
 }
+
+BOOST_AUTO_TEST_CASE(testDurableNumber)
+{
+    auto blockChain =
+        std::dynamic_pointer_cast<MockBlockChain>(m_ledgerManager->blockChain(groupId));
+    BOOST_REQUIRE(blockChain);
+    std::string blockHash = "0x067150c07dab4facb7160e075548007e067150c07dab4facb7160e075548007e";
+    std::string txHash = "0x7536cf1286b5ce6c110cd4fea5c891467884240c9af366d678eb4191e1c31c6f";
+
+    /// the block and its transactions aren't reported while the block is persisted
+    blockChain->m_persisting = true;
+    BOOST_CHECK_THROW(rpc->getBlockByHash(groupId, blockHash, false), JsonRpcException);
+    BOOST_CHECK_THROW(rpc->getBlockByNumber(groupId, "0x0", false), JsonRpcException);
+    BOOST_CHECK_THROW(
+        rpc->getTransactionByBlockHashAndIndex(groupId, blockHash, "0x0"), JsonRpcException);
+    BOOST_CHECK_THROW(
+        rpc->getTransactionByBlockNumberAndIndex(groupId, "0x0", "0x0"), JsonRpcException);
+    BOOST_CHECK(rpc->getTransactionByHash(groupId, txHash).isNull());
+    BOOST_CHECK(rpc->getTransactionReceipt(groupId, txHash).isNull());
+
+    blockChain->m_persisting = false;
+    BOOST_CHECK(rpc->getBlockByHash(groupId, blockHash, false)["number"].asString() == "0x0");
+    BOOST_CHECK(rpc->getBlockByNumber(groupId, "0x0", false)["hash"].asString() == blockHash);
+    BOOST_CHECK(rpc->getTransactionByHash(groupId, txHash)["blockNumber"].asString() == "0x0");
+    BOOST_CHECK(rpc->getTransactionReceipt(groupId, txHash)["blockNumber"].asString() == "0x0");
+}
+
 BOOST_AUTO_TEST_CASE(testGetpendingTransactions)
 {
     Json::Value response = rpc->getPendingTransactions(groupId);
@@ -0,0 +1,139 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+#include "MemoryStorage.h"
+#include <libstorage/AsyncCommitStorage.h>
+#include <libstorage/StorageException.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+
+using namespace dev;
+using namespace dev::storage;
+
+namespace test_AsyncCommitStorage
+{
+/// backend whose commits block until release() is called
+class BlockingStorage : public MemoryStorage
+{
+public:
+    virtual size_t commit(
+        h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash) override
+    {
+        m_released.wait();
+        if (fail)
+        {
+            BOOST_THROW_EXCEPTION(StorageException(-1, "commit failed"));
+        }
+        ++commitCount;
+        return MemoryStorage::commit(hash, num, datas, blockHash);
+    }
+    void release() { m_release.set_value(); }
+
+    std::atomic<size_t> commitCount = {0};
+    bool fail = false;
+
+private:
+    std::promise<void> m_release;
+    std::shared_future<void> m_released = m_release.get_future().share();
+};
+
+struct AsyncCommitStorageFixture
+{
+    AsyncCommitStorageFixture()
+    {
+        backend = std::make_shared<BlockingStorage>();
+        storage = std::make_shared<AsyncCommitStorage>(backend, 2);
+    }
+
+    std::vector<TableData::Ptr> getDatas(const std::string& value)
+    {
+        TableData::Ptr tableData = std::make_shared<TableData>();
+        tableData->tableName = "t_test";
+        Entries::Ptr entries = std::make_shared<Entries>();
+        Entry::Ptr entry = std::make_shared<Entry>();
+        entry->setField("value", value);
+        entries->addEntry(entry);
+        tableData->data.insert(std::make_pair(std::string("LiSi"), entries));
+        return std::vector<TableData::Ptr>{tableData};
+    }
+
+    std::shared_ptr<BlockingStorage> backend;
+    AsyncCommitStorage::Ptr storage;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AsyncCommitStorageTest, AsyncCommitStorageFixture)
+
+BOOST_AUTO_TEST_CASE(selectStaged)
+{
+    BOOST_CHECK_EQUAL(storage->pendingNumber(), -1);
+    storage->commit(h256(0x01), 1, getDatas("1"), h256(0x01));
+    storage->commit(h256(0x02), 2, getDatas("2"), h256(0x02));
+
+    // readers see the latest block before it reaches the backend
+    auto entries = storage->select(h256(0), 0, "t_test", "LiSi");
+    BOOST_CHECK_EQUAL(entries->size(), 1u);
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("value"), "2");
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("_num_"), "2");
+    BOOST_CHECK_EQUAL(backend->commitCount, 0u);
+    BOOST_CHECK_EQUAL(storage->pendingNumber(), 1);
+
+    backend->release();
+    storage->flush();
+    BOOST_CHECK_EQUAL(backend->commitCount, 2u);
+    BOOST_CHECK_EQUAL(storage->pendingNumber(), -1);
+    entries = storage->select(h256(0), 0, "t_test", "LiSi");
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("value"), "2");
+}
+
+BOOST_AUTO_TEST_CASE(persistHandler)
+{
+    std::vector<std::pair<int64_t, int64_t>> persisted;
+    storage->setPersistHandler([&](int64_t _num) {
+        persisted.emplace_back(_num, storage->pendingNumber());
+    });
+    storage->commit(h256(0x01), 1, getDatas("1"), h256(0x01));
+    storage->commit(h256(0x02), 2, getDatas("2"), h256(0x02));
+    BOOST_CHECK(persisted.empty());
+
+    backend->release();
+    storage->flush();
+    // in order, each one once the block is no longer pending
+    BOOST_REQUIRE_EQUAL(persisted.size(), 2u);
+    BOOST_CHECK_EQUAL(persisted[0].first, 1);
+    BOOST_CHECK_EQUAL(persisted[0].second, 2);
+    BOOST_CHECK_EQUAL(persisted[1].first, 2);
+    BOOST_CHECK_EQUAL(persisted[1].second, -1);
+    storage->setPersistHandler(nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(commitFailed)
+{
+    backend->fail = true;
+    storage->commit(h256(0x01), 1, getDatas("1"), h256(0x01));
+    backend->release();
+    BOOST_CHECK_THROW(storage->flush(), StorageException);
+    BOOST_CHECK_THROW(
+        storage->commit(h256(0x02), 2, getDatas("2"), h256(0x02)), StorageException);
+    // the failed block is still pending
+    BOOST_CHECK_EQUAL(storage->pendingNumber(), 1);
+    backend->fail = false;
+    storage.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test_AsyncCommitStorage
@@ -0,0 +1,172 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+#include "MemoryStorage.h"
+#include <libstorage/CachedStorage.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace dev;
+using namespace dev::storage;
+
+namespace test_CachedStorage
+{
+class CountingStorage : public MemoryStorage
+{
+public:
+    virtual Entries::Ptr select(
+        h256 hash, int num, const std::string& table, const std::string& key) override
+    {
+        ++selectCount;
+        return MemoryStorage::select(hash, num, table, key);
+    }
+    size_t selectCount = 0;
+};
+
+struct CachedStorageFixture
+{
+    CachedStorageFixture()
+    {
+        backend = std::make_shared<CountingStorage>();
+        cachedStorage = std::make_shared<CachedStorage>(backend, 1024 * 1024, 4);
+    }
+
+    TableData::Ptr getTableData(const std::string& key, const std::string& value)
+    {
+        TableData::Ptr tableData = std::make_shared<TableData>();
+        tableData->tableName = "t_test";
+        Entries::Ptr entries = std::make_shared<Entries>();
+        Entry::Ptr entry = std::make_shared<Entry>();
+        entry->setField("name", key);
+        entry->setField("value", value);
+        entries->addEntry(entry);
+        tableData->data.insert(std::make_pair(key, entries));
+        return tableData;
+    }
+
+    std::shared_ptr<CountingStorage> backend;
+    CachedStorage::Ptr cachedStorage;
+};
+
+BOOST_FIXTURE_TEST_SUITE(CachedStorageTest, CachedStorageFixture)
+
+BOOST_AUTO_TEST_CASE(selectHit)
+{
+    backend->commit(h256(0), 0, {getTableData("LiSi", "1")}, h256(0));
+
+    auto entries = cachedStorage->select(h256(0), 0, "t_test", "LiSi");
+    BOOST_CHECK_EQUAL(entries->size(), 1u);
+    entries = cachedStorage->select(h256(0), 0, "t_test", "LiSi");
+    BOOST_CHECK_EQUAL(entries->size(), 1u);
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("value"), "1");
+    BOOST_CHECK_EQUAL(backend->selectCount, 1u);
+
+    // not found results are cached as well
+    cachedStorage->select(h256(0), 0, "t_test", "ZhangSan");
+    cachedStorage->select(h256(0), 0, "t_test", "ZhangSan");
+    BOOST_CHECK_EQUAL(backend->selectCount, 2u);
+
+    auto stats = cachedStorage->stats();
+    BOOST_CHECK_EQUAL(stats.hit, 2u);
+    BOOST_CHECK_EQUAL(stats.miss, 2u);
+    BOOST_CHECK_EQUAL(stats.size, 2u);
+    BOOST_CHECK(stats.memory > 0u);
+}
+
+BOOST_AUTO_TEST_CASE(selectReturnsCopy)
+{
+    backend->commit(h256(0), 0, {getTableData("LiSi", "1")}, h256(0));
+
+    auto entries = cachedStorage->select(h256(0), 0, "t_test", "LiSi");
+    entries->get(0)->setField("value", "2");
+    entries = cachedStorage->select(h256(0), 0, "t_test", "LiSi");
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("value"), "1");
+}
+
+BOOST_AUTO_TEST_CASE(commitUpdatesCache)
+{
+    cachedStorage->select(h256(0), 0, "t_test", "LiSi");
+
+    auto tableData = getTableData("LiSi", "3");
+    Entry::Ptr deleted = std::make_shared<Entry>();
+    deleted->setField("name", "LiSi");
+    deleted->setStatus(Entry::Status::DELETED);
+    tableData->data["LiSi"]->addEntry(deleted);
+    cachedStorage->commit(h256(0x02), 2, {tableData}, h256(0x02));
+
+    auto entries = cachedStorage->select(h256(0), 0, "t_test", "LiSi");
+    BOOST_CHECK_EQUAL(backend->selectCount, 1u);
+    BOOST_CHECK_EQUAL(entries->size(), 1u);
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("value"), "3");
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("_num_"), "2");
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("_hash_"), h256(0x02).hex());
+}
+
+BOOST_AUTO_TEST_CASE(batchSelect)
+{
+    auto tableData = getTableData("LiSi", "1");
+    tableData->data.insert(*getTableData("ZhangSan", "2")->data.begin());
+    backend->commit(h256(0), 0, {tableData}, h256(0));
+    cachedStorage->select(h256(0), 0, "t_test", "LiSi");
+
+    std::vector<TableKey> keys{{"t_test", "LiSi"}, {"t_test", "ZhangSan"}, {"t_test", "WangWu"}};
+    auto result = cachedStorage->batchSelect(h256(0), 0, keys);
+    BOOST_REQUIRE_EQUAL(result.size(), 3u);
+    BOOST_CHECK_EQUAL(result[0]->get(0)->getField("value"), "1");
+    BOOST_CHECK_EQUAL(result[1]->get(0)->getField("value"), "2");
+    BOOST_CHECK_EQUAL(result[2]->size(), 0u);
+    // only the misses are read from the backend
+    BOOST_CHECK_EQUAL(backend->selectCount, 3u);
+
+    result[1]->get(0)->setField("value", "3");
+    result = cachedStorage->batchSelect(h256(0), 0, keys);
+    BOOST_CHECK_EQUAL(result[1]->get(0)->getField("value"), "2");
+    BOOST_CHECK_EQUAL(backend->selectCount, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(prefetch)
+{
+    backend->commit(h256(0), 0, {getTableData("LiSi", "1")}, h256(0));
+    cachedStorage->prefetch(h256(0), 0, {{"t_test", "LiSi"}, {"t_test", "ZhangSan"}});
+    BOOST_CHECK_EQUAL(backend->selectCount, 2u);
+
+    auto entries = cachedStorage->select(h256(0), 0, "t_test", "LiSi");
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("value"), "1");
+    cachedStorage->select(h256(0), 0, "t_test", "ZhangSan");
+    BOOST_CHECK_EQUAL(backend->selectCount, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(eviction)
+{
+    cachedStorage = std::make_shared<CachedStorage>(backend, 4096, 1);
+    for (int i = 0; i < 100; ++i)
+    {
+        cachedStorage->commit(h256(0), 1, {getTableData(std::to_string(i), "v")}, h256(0));
+    }
+    auto stats = cachedStorage->stats();
+    BOOST_CHECK(stats.memory <= stats.capacity);
+    BOOST_CHECK(stats.size < 100u);
+
+    // the most recent key survives, the oldest one is reloaded from the backend
+    cachedStorage->select(h256(0), 0, "t_test", "99");
+    BOOST_CHECK_EQUAL(backend->selectCount, 0u);
+    cachedStorage->select(h256(0), 0, "t_test", "0");
+    BOOST_CHECK_EQUAL(backend->selectCount, 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test_CachedStorage
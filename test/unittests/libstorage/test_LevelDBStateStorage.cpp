@@ -15,6 +15,7 @@
  * (c) 2016-2018 fisco-dev contributors.
  */
 
+#include "libstorage/EntriesCodec.h"
 #include "libstorage/LevelDBStorage.h"
 #include <leveldb/db.h>
 #include <libdevcore/BasicLevelDB.h>
@@ -187,7 +188,7 @@ struct LevelDBFixture
     LevelDBFixture()
     {
         levelDB = std::make_shared<dev::storage::LevelDBStorage>();
-        std::shared_ptr<MockLevelDB> mockLevelDB = std::make_shared<MockLevelDB>();
+        mockLevelDB = std::make_shared<MockLevelDB>();
         levelDB->setDB(mockLevelDB);
     }
     Entries::Ptr getEntries()
@@ -200,6 +201,7 @@ struct LevelDBFixture
         return entries;
     }
     dev::storage::LevelDBStorage::Ptr levelDB;
+    std::shared_ptr<MockLevelDB> mockLevelDB;
 };
 
 BOOST_FIXTURE_TEST_SUITE(LevelDB, LevelDBFixture);
@@ -242,6 +244,108 @@ BOOST_AUTO_TEST_CASE(commit)
     BOOST_CHECK_EQUAL(entries->size(), 1u);
 }
 
+BOOST_AUTO_TEST_CASE(commitWithSchema)
+{
+    h256 h(0x01);
+    int num = 10;
+    h256 blockHash(0x11231);
+    dev::storage::TableData::Ptr tableData = std::make_shared<dev::storage::TableData>();
+    tableData->tableName = "t_test";
+    tableData->info = std::make_shared<TableInfo>();
+    tableData->info->name = "t_test";
+    tableData->info->key = "Name";
+    tableData->info->fields =
+        std::vector<std::string>{"id", "memo", STATUS, "Name", "_hash_", "_num_"};
+    Entries::Ptr entries = getEntries();
+    Entry::Ptr deleted = std::make_shared<Entry>();
+    deleted->setField("Name", "LiSi");
+    deleted->setField("id", "2");
+    deleted->setStatus(Entry::Status::DELETED);
+    entries->addEntry(deleted);
+    Entry::Ptr empty = std::make_shared<Entry>();
+    empty->setField("Name", "LiSi");
+    empty->setField("id", "");
+    entries->addEntry(empty);
+    tableData->data.insert(std::make_pair(std::string("LiSi"), entries));
+    std::vector<dev::storage::TableData::Ptr> datas{tableData};
+    BOOST_CHECK_EQUAL(levelDB->commit(h, num, datas, blockHash), 1u);
+
+    entries = levelDB->select(h, num, "t_test", "LiSi");
+    BOOST_CHECK_EQUAL(entries->size(), 2u);
+    auto entry = entries->get(0);
+    BOOST_CHECK_EQUAL(entry->getField("Name"), "LiSi");
+    BOOST_CHECK_EQUAL(entry->getField("id"), "1");
+    BOOST_CHECK_EQUAL(entry->getField("_hash_"), h.hex());
+    BOOST_CHECK_EQUAL(entry->getField("_num_"), "10");
+    BOOST_CHECK_EQUAL(entry->dirty(), false);
+    // fields which were never set stay absent
+    BOOST_CHECK(entry->findField("memo") == nullptr);
+    BOOST_CHECK_EQUAL(entries->get(1)->getField("id"), "");
+}
+
+BOOST_AUTO_TEST_CASE(batchSelect)
+{
+    h256 h(0x01);
+    dev::storage::TableData::Ptr tableData = std::make_shared<dev::storage::TableData>();
+    tableData->tableName = "t_test";
+    for (int i = 0; i < 40; ++i)
+    {
+        Entries::Ptr entries = std::make_shared<Entries>();
+        Entry::Ptr entry = std::make_shared<Entry>();
+        entry->setField("Name", std::to_string(i));
+        entries->addEntry(entry);
+        tableData->data.insert(std::make_pair(std::to_string(i), entries));
+    }
+    std::vector<dev::storage::TableData::Ptr> datas{tableData};
+    levelDB->commit(h, 1, datas, h);
+
+    levelDB->setReadThreads(2);
+    std::vector<dev::storage::TableKey> keys;
+    for (int i = 0; i < 50; ++i)
+    {
+        keys.push_back(dev::storage::TableKey{"t_test", std::to_string(i)});
+    }
+    auto result = levelDB->batchSelect(h, 1, keys);
+    BOOST_REQUIRE_EQUAL(result.size(), 50u);
+    for (int i = 0; i < 50; ++i)
+    {
+        BOOST_REQUIRE_EQUAL(result[i]->size(), i < 40 ? 1u : 0u);
+        if (i < 40)
+        {
+            BOOST_CHECK_EQUAL(result[i]->get(0)->getField("Name"), std::to_string(i));
+        }
+    }
+
+    keys.push_back(dev::storage::TableKey{"e", "Exception"});
+    BOOST_CHECK_THROW(levelDB->batchSelect(h, 1, keys), boost::exception);
+}
+
+BOOST_AUTO_TEST_CASE(selectLegacyJson)
+{
+    std::string value =
+        "{\"values\":[{\"Name\":\"LiSi\",\"id\":\"1\",\"_status_\":\"0\",\"_hash_\":"
+        "\"01\",\"_num_\":1},{\"Name\":\"LiSi\",\"id\":\"2\",\"_status_\":\"1\"}]}";
+    auto batch = mockLevelDB->createWriteBatch();
+    batch->insertSlice(leveldb::Slice("t_test_LiSi"), leveldb::Slice(value));
+    mockLevelDB->Write(leveldb::WriteOptions(), &(batch->writeBatch()));
+
+    Entries::Ptr entries = levelDB->select(h256(0x01), 1, "t_test", "LiSi");
+    BOOST_CHECK_EQUAL(entries->size(), 1u);
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("id"), "1");
+    BOOST_CHECK_EQUAL(entries->get(0)->getField("_num_"), "1");
+}
+
+BOOST_AUTO_TEST_CASE(selectMalformed)
+{
+    std::string value = EntriesCodec::encode(getEntries(), nullptr, h256(0x01), 1);
+    value.resize(value.size() - 2);
+    auto batch = mockLevelDB->createWriteBatch();
+    batch->insertSlice(leveldb::Slice("t_test_LiSi"), leveldb::Slice(value));
+    mockLevelDB->Write(leveldb::WriteOptions(), &(batch->writeBatch()));
+
+    BOOST_CHECK_THROW(levelDB->select(h256(0x01), 1, "t_test", "LiSi"), boost::exception);
+}
+
 BOOST_AUTO_TEST_CASE(exception)
 {
     h256 h(0x01);
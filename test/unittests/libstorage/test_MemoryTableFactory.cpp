@@ -18,6 +18,7 @@
 #include "Common.h"
 #include <libdevcore/FixedHash.h>
 #include <libdevcore/easylog.h>
+#include <libdevcrypto/Hash.h>
 #include <libstorage/Common.h>
 #include <libstorage/MemoryTable.h>
 #include <libstorage/MemoryTableFactory.h>
@@ -64,6 +65,54 @@ struct MemoryTableFactoryFixture
         BOOST_TEST_TRUE(memoryDBFactory->stateStorage() == mockAMOPDB);
     }
 
+    dev::storage::MemoryTableFactory::Ptr newFactory()
+    {
+        auto factory = std::make_shared<dev::storage::MemoryTableFactory>();
+        factory->setStateStorage(memoryDBFactory->stateStorage());
+        return factory;
+    }
+
+    void insertConfig(dev::storage::MemoryTableFactory::Ptr factory, const std::string& key)
+    {
+        auto table = factory->openTable(SYS_CONFIG);
+        auto entry = table->newEntry();
+        entry->setField("key", key);
+        entry->setField("value", "1");
+        entry->setField("enable_num", "1");
+        table->insert(key, entry);
+    }
+
+    /// the table hash as defined before the dirty keys were tracked, over the given keys in order
+    h256 fullHash(Table::Ptr table, std::set<std::string> const& keys)
+    {
+        bytes data;
+        for (auto& key : keys)
+        {
+            auto entries = table->select(key, table->newCondition());
+            if (entries->size() == 0u)
+            {
+                continue;
+            }
+            data.insert(data.end(), key.begin(), key.end());
+            for (size_t i = 0; i < entries->size(); ++i)
+            {
+                auto entry = entries->get(i);
+                if (!entry->dirty())
+                {
+                    continue;
+                }
+                entry->forEachField([&data](const std::string& name, const std::string& value) {
+                    if (name == STATUS || (name.front() != '_' && name.back() != '_'))
+                    {
+                        data.insert(data.end(), name.begin(), name.end());
+                        data.insert(data.end(), value.begin(), value.end());
+                    }
+                });
+            }
+        }
+        return data.empty() ? h256() : sha256(&data);
+    }
+
     dev::storage::MemoryTableFactory::Ptr memoryDBFactory;
 };
 
@@ -125,6 +174,264 @@ BOOST_AUTO_TEST_CASE(open_sysTables)
     table = memoryDBFactory->openTable(SYS_HASH_2_BLOCK);
 }
 
+BOOST_AUTO_TEST_CASE(mergeIndependent)
+{
+    insertConfig(memoryDBFactory, "a");
+    insertConfig(memoryDBFactory, "b");
+
+    // the same writes on separate factories, merged in order
+    auto merged = newFactory();
+    auto first = newFactory();
+    insertConfig(first, "a");
+    auto second = newFactory();
+    insertConfig(second, "b");
+    BOOST_TEST(!merged->conflicts(*first));
+    merged->merge(*first);
+    BOOST_TEST(!merged->conflicts(*second));
+    merged->merge(*second);
+    BOOST_TEST(merged->hash() == memoryDBFactory->hash());
+
+    // reading a row written before conflicts
+    auto third = newFactory();
+    auto table = third->openTable(SYS_CONFIG);
+    table->select("a", table->newCondition());
+    BOOST_TEST(merged->conflicts(*third));
+}
+
+BOOST_AUTO_TEST_CASE(mergeCreatedTable)
+{
+    auto createTable = [](dev::storage::MemoryTableFactory::Ptr factory) {
+        auto table = factory->createTable("t_test", "key", "value", true);
+        auto entry = table->newEntry();
+        entry->setField("key", "name");
+        entry->setField("value", "Lili");
+        table->insert("name", entry);
+    };
+    createTable(memoryDBFactory);
+
+    auto merged = newFactory();
+    auto created = newFactory();
+    createTable(created);
+    BOOST_TEST(!merged->conflicts(*created));
+    merged->merge(*created);
+    BOOST_TEST(merged->hash() == memoryDBFactory->hash());
+    auto table = merged->openTable("t_test");
+    BOOST_TEST(table->select("name", table->newCondition())->size() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(rollbackCreatedTable)
+{
+    auto savepoint = memoryDBFactory->savepoint();
+    BOOST_TEST(memoryDBFactory->createTable("t_test", "key", "value", true) != nullptr);
+    memoryDBFactory->rollback(savepoint);
+    BOOST_TEST(memoryDBFactory->openTable("t_test") == nullptr);
+    BOOST_TEST(memoryDBFactory->createTable("t_test", "key", "value", true) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(hashDirtyKeys)
+{
+    auto table = memoryDBFactory->createTable("t_test", "key", "value", true);
+    BOOST_TEST(table->hash() == h256());
+    std::set<std::string> keys;
+    for (int i = 9; i >= 0; --i)
+    {
+        auto key = "key" + std::to_string(i);
+        auto entry = table->newEntry();
+        entry->setField("key", key);
+        entry->setField("value", std::to_string(i));
+        table->insert(key, entry);
+        keys.insert(key);
+    }
+    auto inserted = table->hash();
+    BOOST_TEST(inserted == fullHash(table, keys));
+
+    // rolled back changes leave the hash as it was
+    auto savepoint = memoryDBFactory->savepoint();
+    auto entry = table->newEntry();
+    entry->setField("value", "changed");
+    auto condition = table->newCondition();
+    condition->EQ("key", "key3");
+    BOOST_TEST(table->update("key3", entry, condition) == 1);
+    BOOST_TEST(table->remove("key5", table->newCondition()) == 1);
+    entry = table->newEntry();
+    entry->setField("key", "new");
+    table->insert("new", entry);
+    keys.insert("new");
+    BOOST_TEST(table->hash() != inserted);
+    BOOST_TEST(table->hash() == fullHash(table, keys));
+    memoryDBFactory->rollback(savepoint);
+    BOOST_TEST(table->hash() == inserted);
+    BOOST_TEST(table->hash() == fullHash(table, keys));
+
+    // entries changed in place through select are part of the hash
+    table->select("key1", table->newCondition())->get(0)->setField("value", "in place");
+    BOOST_TEST(table->hash() == fullHash(table, keys));
+    BOOST_TEST(table->hash() != inserted);
+
+    // the rows merged into another factory hash the same
+    auto merged = newFactory();
+    merged->merge(*memoryDBFactory);
+    BOOST_TEST(merged->openTable("t_test")->hash() == table->hash());
+    BOOST_TEST(merged->hash() == memoryDBFactory->hash());
+}
+
+BOOST_AUTO_TEST_CASE(selectNumbers)
+{
+    memoryDBFactory->setExactConditions(true);
+    auto table = memoryDBFactory->createTable("t_test", "key", "value", true);
+    for (auto value : {"5", "18446744073709551616", "-3", "", "007", "abc"})
+    {
+        auto entry = table->newEntry();
+        entry->setField("key", "k");
+        entry->setField("value", value);
+        table->insert("k", entry);
+    }
+    auto condition = table->newCondition();
+    condition->GT("value", "4");
+    BOOST_TEST(table->select("k", condition)->size() == 3u);
+    condition = table->newCondition();
+    condition->LE("value", "0");
+    BOOST_TEST(table->select("k", condition)->size() == 2u);
+    condition = table->newCondition();
+    condition->GE("value", "18446744073709551616");
+    BOOST_TEST(table->select("k", condition)->size() == 1u);
+
+    condition = table->newCondition();
+    condition->NE("value", "abc");
+    condition->limit(1, 2);
+    auto entries = table->select("k", condition);
+    BOOST_REQUIRE(entries->size() == 2u);
+    BOOST_TEST(entries->get(0)->getField("value") == "18446744073709551616");
+    BOOST_TEST(entries->get(1)->getField("value") == "-3");
+}
+
+BOOST_AUTO_TEST_CASE(selectNumbersInt)
+{
+    // chains created without storage.exactConditions
+    auto table = memoryDBFactory->createTable("t_test", "key", "value", true);
+    for (auto value : {"5", "2147483648", "-2147483648", "", "007", "abc"})
+    {
+        auto entry = table->newEntry();
+        entry->setField("key", "k");
+        entry->setField("value", value);
+        table->insert("k", entry);
+    }
+    auto condition = table->newCondition();
+    condition->GT("value", "4");
+    BOOST_TEST(table->select("k", condition)->size() == 2u);
+    condition = table->newCondition();
+    condition->LE("value", "0");
+    BOOST_TEST(table->select("k", condition)->size() == 2u);
+    condition = table->newCondition();
+    condition->LE("value", "2147483648");
+    BOOST_TEST(table->select("k", condition)->size() == 0u);
+
+    condition = table->newCondition();
+    condition->NE("value", "abc");
+    condition->limit(1, 2);
+    BOOST_TEST(table->select("k", condition)->size() == 5u);
+}
+
+BOOST_AUTO_TEST_CASE(selectCopies)
+{
+    auto table = memoryDBFactory->createTable("t_test", "key", "value", true);
+    auto entry = table->newEntry();
+    entry->setField("key", "k");
+    entry->setField("value", "1");
+    table->insert("k", entry);
+    table->select("k", table->newCondition())->get(0)->setField("value", "2");
+    BOOST_TEST(table->select("k", table->newCondition())->get(0)->getField("value") == "2");
+
+    // the cached row can't be changed through a selected one
+    memoryDBFactory->setSelectCopies(true);
+    table->select("k", table->newCondition())->get(0)->setField("value", "3");
+    BOOST_TEST(table->select("k", table->newCondition())->get(0)->getField("value") == "2");
+    auto other = memoryDBFactory->createTable("t_other", "key", "value", true);
+    entry = other->newEntry();
+    entry->setField("key", "k");
+    entry->setField("value", "1");
+    other->insert("k", entry);
+    other->select("k", other->newCondition())->get(0)->setField("value", "3");
+    BOOST_TEST(other->select("k", other->newCondition())->get(0)->getField("value") == "1");
+}
+
+BOOST_AUTO_TEST_CASE(selectIndexed)
+{
+    auto table = memoryDBFactory->openTable(SYS_ACCESS_TABLE);
+    const size_t rows = 100;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        auto entry = table->newEntry();
+        entry->setField("table_name", "t_test");
+        entry->setField("address", std::to_string(i % 10));
+        entry->setField("enable_num", std::to_string(i));
+        table->insert("t_test", entry);
+    }
+    auto select = [&](std::string const& address) {
+        auto condition = table->newCondition();
+        condition->EQ("address", address);
+        condition->GE("enable_num", "50");
+        return table->select("t_test", condition);
+    };
+    BOOST_TEST(select("3")->size() == 5u);
+    BOOST_TEST(select("10")->size() == 0u);
+
+    // the index follows the changes through the table and in place
+    auto entry = table->newEntry();
+    entry->setField("address", "10");
+    auto condition = table->newCondition();
+    condition->EQ("address", "3");
+    condition->EQ("enable_num", "93");
+    BOOST_TEST(table->update("t_test", entry, condition) == 1);
+    BOOST_TEST(select("3")->size() == 4u);
+    BOOST_TEST(select("10")->size() == 1u);
+    select("10")->get(0)->setField("address", "11");
+    BOOST_TEST(select("10")->size() == 0u);
+    BOOST_TEST(select("11")->size() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(selectIndexedUserTable)
+{
+    BOOST_TEST(memoryDBFactory->createTable("t_bad", "key", "item,num", true, Address(), "id") ==
+               nullptr);
+    BOOST_TEST(memoryDBFactory->openTable("t_bad") == nullptr);
+
+    auto table = memoryDBFactory->createTable("t_test", "key", "item,num", true, Address(), "item");
+    BOOST_REQUIRE(table != nullptr);
+    BOOST_TEST(table->tableInfo()->indices == std::vector<std::string>{"item"});
+    auto sysTable = memoryDBFactory->openTable(SYS_TABLES);
+    BOOST_TEST(sysTable->select("t_test", sysTable->newCondition())
+                   ->get(0)
+                   ->getField("index_field") == "item");
+    const size_t rows = 64;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        auto entry = table->newEntry();
+        entry->setField("key", "k");
+        entry->setField("item", std::to_string(i % 8));
+        entry->setField("num", std::to_string(i));
+        table->insert("k", entry);
+    }
+    auto condition = table->newCondition();
+    condition->EQ("item", "3");
+    auto entries = table->select("k", condition);
+    BOOST_REQUIRE(entries->size() == rows / 8);
+    BOOST_TEST(entries->get(0)->getField("num") == "3");
+    BOOST_TEST(entries->get(7)->getField("num") == "59");
+    condition->GT("num", "50");
+    BOOST_TEST(table->select("k", condition)->size() == 2u);
+    condition = table->newCondition();
+    condition->EQ("item", "8");
+    BOOST_TEST(table->select("k", condition)->size() == 0u);
+
+    // tables without indexes don't get the field
+    memoryDBFactory->createTable("t_plain", "key", "item", true);
+    BOOST_TEST(sysTable->select("t_plain", sysTable->newCondition())
+                   ->get(0)
+                   ->findField("index_field") == nullptr);
+    BOOST_TEST(memoryDBFactory->openTable("t_plain")->tableInfo()->indices.empty());
+}
+
 BOOST_AUTO_TEST_CASE(setBlockHash)
 {
     memoryDBFactory->setBlockHash(h256(0x12345));
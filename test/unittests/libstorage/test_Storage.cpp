@@ -61,6 +61,47 @@ BOOST_AUTO_TEST_CASE(entryTest)
     BOOST_TEST_TRUE(entry->dirty() == false);
 }
 
+BOOST_AUTO_TEST_CASE(entrySchemaTest)
+{
+    auto schema = std::make_shared<EntrySchema>(
+        std::vector<std::string>{"value", STATUS, "key", "value", "_hash_"});
+    BOOST_TEST_TRUE(schema->size() == 4u);
+    BOOST_TEST_TRUE(schema->slot("key") >= 0);
+    BOOST_TEST_TRUE(schema->slot("memo") == -1);
+
+    auto fields = [](Entry::Ptr _entry) {
+        std::vector<std::string> ret;
+        _entry->forEachField([&ret](const std::string& name, const std::string& value) {
+            ret.push_back(name + "=" + value);
+        });
+        return ret;
+    };
+    // the fields out of the schema are listed in the order of the names as well
+    auto schemaEntry = std::make_shared<Entry>(schema);
+    entry->setDirty(false);
+    for (auto e : {schemaEntry, entry})
+    {
+        e->setField("value", "1");
+        e->setField("memo", "m");
+        e->setField("key", "k");
+        e->setField("a", "");
+    }
+    BOOST_TEST_TRUE(fields(schemaEntry) == fields(entry));
+    BOOST_TEST_TRUE(fields(entry).front() == "_status_=0");
+    BOOST_TEST_TRUE(schemaEntry->getField("memo") == "m");
+    BOOST_TEST_TRUE(schemaEntry->findField("_hash_") == nullptr);
+    BOOST_TEST_TRUE(schemaEntry->getField("_hash_") == "");
+
+    entry->setDirty(false);
+    entry->setSchema(schema);
+    BOOST_TEST_TRUE(entry->dirty() == false);
+    BOOST_TEST_TRUE(fields(schemaEntry) == fields(entry));
+    auto copy = std::make_shared<Entry>(*entry);
+    copy->setField("key", "changed");
+    BOOST_TEST_TRUE(entry->getField("key") == "k");
+    BOOST_TEST_TRUE(copy->getField("key") == "changed");
+}
+
 BOOST_AUTO_TEST_CASE(entriesTest)
 {
     BOOST_TEST_TRUE(entries->size() == 0u);
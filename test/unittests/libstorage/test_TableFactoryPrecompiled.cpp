@@ -126,6 +126,18 @@ BOOST_AUTO_TEST_CASE(call_afterBlock)
     memTable->insert("张三", entry);
 }
 
+BOOST_AUTO_TEST_CASE(createIndexedTable)
+{
+    dev::eth::ContractABI abi;
+    bytes param = abi.abiIn("createTable(string,string,string,string)", "t_test", "id",
+        "item_name, item_id", " item_id");
+    tableFactoryPrecompiled->call(context, bytesConstRef(&param));
+    auto table = tableFactoryPrecompiled->getmemoryTableFactory()->openTable(
+        storage::USER_TABLE_PREFIX + std::string("t_test"));
+    BOOST_REQUIRE(table != nullptr);
+    BOOST_TEST(table->tableInfo()->indices == std::vector<std::string>{"item_id"});
+}
+
 BOOST_AUTO_TEST_CASE(hash)
 {
     h256 h = tableFactoryPrecompiled->hash();
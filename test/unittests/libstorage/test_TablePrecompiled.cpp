@@ -184,6 +184,79 @@ BOOST_AUTO_TEST_CASE(call_update2)
     BOOST_TEST(num == 0u);
 }
 
+BOOST_AUTO_TEST_CASE(transientPrecompiled)
+{
+    eth::ContractABI abi;
+    bytes in = abi.abiIn("newEntry()");
+    bytes out = tablePrecompiled->call(context, bytesConstRef(&in));
+    Address entryAddress;
+    abi.abiOut(bytesConstRef(&out), entryAddress);
+    auto table = context->registerPrecompiled(tablePrecompiled);
+    in = abi.abiIn("newCondition()");
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    Address conditionAddress;
+    abi.abiOut(bytesConstRef(&out), conditionAddress);
+
+    BOOST_TEST(entryAddress != conditionAddress);
+    BOOST_TEST(std::dynamic_pointer_cast<EntryPrecompiled>(context->getPrecompiled(entryAddress)));
+    BOOST_TEST(context->getPrecompiled(table) == tablePrecompiled);
+    BOOST_TEST(std::dynamic_pointer_cast<ConditionPrecompiled>(
+        context->getPrecompiled(conditionAddress)));
+
+    // freed at the end of the transaction, the addresses are not reused
+    context->clearTransientPrecompiled();
+    BOOST_TEST(!context->getPrecompiled(entryAddress));
+    BOOST_TEST(!context->getPrecompiled(conditionAddress));
+    BOOST_TEST(context->getPrecompiled(table) == tablePrecompiled);
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    Address nextAddress;
+    abi.abiOut(bytesConstRef(&out), nextAddress);
+    BOOST_TEST(nextAddress != conditionAddress);
+    BOOST_TEST(std::dynamic_pointer_cast<ConditionPrecompiled>(
+        context->getPrecompiled(nextAddress)));
+}
+
+BOOST_AUTO_TEST_CASE(danglingHandle)
+{
+    eth::ContractABI abi;
+    bytes in = abi.abiIn("newEntry()");
+    bytes out = tablePrecompiled->call(context, bytesConstRef(&in));
+    Address entryAddress;
+    abi.abiOut(bytesConstRef(&out), entryAddress);
+    in = abi.abiIn("newCondition()");
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    Address conditionAddress;
+    abi.abiOut(bytesConstRef(&out), conditionAddress);
+    context->clearTransientPrecompiled();
+
+    // handles of a finished transaction are rejected instead of dereferenced
+    in = abi.abiIn("select(string,address)", "name", conditionAddress);
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    Address entriesAddress;
+    abi.abiOut(bytesConstRef(&out), entriesAddress);
+    BOOST_TEST(entriesAddress == Address());
+
+    u256 num;
+    in = abi.abiIn("insert(string,address)", "name", entryAddress);
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    abi.abiOut(bytesConstRef(&out), num);
+    BOOST_TEST(num == u256(-1));
+
+    in = abi.abiIn("remove(string,address)", "name", conditionAddress);
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    abi.abiOut(bytesConstRef(&out), num);
+    BOOST_TEST(num == u256(-1));
+
+    // an entry handle passed as the condition is rejected too
+    in = abi.abiIn("newEntry()");
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    abi.abiOut(bytesConstRef(&out), entryAddress);
+    in = abi.abiIn("update(string,address,address)", "name", entryAddress, entryAddress);
+    out = tablePrecompiled->call(context, bytesConstRef(&in));
+    abi.abiOut(bytesConstRef(&out), num);
+    BOOST_TEST(num == u256(-1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test_TablePrecompiled
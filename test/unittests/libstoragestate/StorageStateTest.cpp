@@ -36,12 +36,13 @@ struct StorageStateFixture
     StorageStateFixture() : m_state(dev::u256(0))
     {
         auto storage = std::make_shared<dev::storage::MemoryStorage>();
-        auto tableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
-        tableFactory->setStateStorage(storage);
-        m_state.setMemoryTableFactory(tableFactory);
+        m_tableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
+        m_tableFactory->setStateStorage(storage);
+        m_state.setMemoryTableFactory(m_tableFactory);
     }
 
     dev::storagestate::StorageState m_state;
+    std::shared_ptr<dev::storage::MemoryTableFactory> m_tableFactory;
 };
 
 BOOST_FIXTURE_TEST_SUITE(StorageState, StorageStateFixture);
@@ -102,6 +103,48 @@ BOOST_AUTO_TEST_CASE(Storage)
     m_state.clearStorage(addr1);
 }
 
+BOOST_AUTO_TEST_CASE(BinaryStorage)
+{
+    m_state.setBinaryStorage(true);
+    Address addr1(0x100001);
+    m_state.createContract(addr1);
+    u256 key = u256(1) << 255;
+    m_state.setStorage(addr1, key, u256(1) << 200);
+    BOOST_TEST(m_state.storage(addr1, key) == u256(1) << 200);
+
+    auto table = m_tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    auto entries = table->select(toBigEndianString(key), table->newCondition());
+    BOOST_REQUIRE(entries->size() == 1u);
+    BOOST_TEST(entries->get(0)->getField("value").size() == 26u);
+    BOOST_TEST(table->select(key.str(), table->newCondition())->size() == 0u);
+
+    // zero is stored as an empty value, small slots can't collide with the account rows
+    m_state.setStorage(addr1, key, u256(0));
+    BOOST_TEST(m_state.storage(addr1, key) == u256(0));
+    entries = table->select(toBigEndianString(key), table->newCondition());
+    BOOST_TEST(entries->get(0)->getField("value") == "");
+    m_state.setStorage(addr1, u256(0), u256(7));
+    BOOST_TEST(m_state.storage(addr1, u256(0)) == u256(7));
+    BOOST_TEST(m_state.balance(addr1) == u256(0));
+}
+
+BOOST_AUTO_TEST_CASE(DecimalStorage)
+{
+    // chains created without state.binaryStorage keep decimal slots
+    Address addr1(0x100002);
+    m_state.createContract(addr1);
+    m_state.setStorage(addr1, u256(123), u256(456));
+    BOOST_TEST(m_state.storage(addr1, u256(123)) == u256(456));
+    BOOST_TEST(m_state.storage(addr1, u256(5)) == u256(0));
+
+    auto table = m_tableFactory->openTable("_contract_data_" + addr1.hex() + "_");
+    auto entries = table->select("123", table->newCondition());
+    BOOST_REQUIRE(entries->size() == 1u);
+    BOOST_TEST(entries->get(0)->getField("value") == "456");
+    BOOST_TEST(
+        table->select(toBigEndianString(u256(123)), table->newCondition())->size() == 0u);
+}
+
 BOOST_AUTO_TEST_CASE(Code)
 {
     Address addr1(0x100001);
@@ -25,8 +25,10 @@
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <test/unittests/libethcore/FakeBlock.h>
 #include <boost/test/unit_test.hpp>
+#include <atomic>
 #include <iostream>
 #include <memory>
+#include <thread>
 
 using namespace std;
 using namespace dev;
@@ -116,6 +118,43 @@ BOOST_AUTO_TEST_CASE(AllTest)
         fakeQueue.size() == c_maxDownloadingBlockQueueSize + c_maxDownloadingBlockQueueBufferSize);
 }
 
+BOOST_AUTO_TEST_CASE(VerifyThreadsTest)
+{
+    DownloadingBlockQueue fakeQueue;
+    std::atomic<int> ready = {0};
+    fakeQueue.setVerifyThreads(2, [&ready]() { ++ready; });
+
+    // 4 shards of 5 blocks, decoded in the background
+    const int shards = 4;
+    const int shardSize = 5;
+    for (int shard = shards - 1; shard >= 0; --shard)
+    {
+        vector<shared_ptr<Block>> blocks;
+        for (int i = shard * shardSize; i < (shard + 1) * shardSize; ++i)
+        {
+            FakeBlock fakeBlock;
+            fakeBlock.getBlock().header().setNumber(static_cast<int64_t>(i));
+            blocks.emplace_back(make_shared<Block>(fakeBlock.getBlock()));
+        }
+        fakeQueue.push(blocks);
+    }
+    fakeQueue.flushBufferToQueue();
+    for (int i = 0; i < 1000 && ready < shards; ++i)
+        this_thread::sleep_for(chrono::milliseconds(10));
+    BOOST_CHECK(ready == shards);
+    BOOST_CHECK(fakeQueue.size() == size_t(shards * shardSize));
+    BOOST_CHECK(fakeQueue.verifyStats().blocks == uint64_t(shards * shardSize));
+
+    // in order whatever shard was decoded first
+    for (int64_t i = 0; i < shards * shardSize; ++i)
+    {
+        BOOST_CHECK(fakeQueue.top()->header().number() == i);
+        fakeQueue.pop();
+    }
+    BOOST_CHECK(fakeQueue.empty());
+    fakeQueue.setVerifyThreads(0, nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
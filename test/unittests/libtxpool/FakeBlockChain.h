@@ -94,6 +94,20 @@ public:
     {
         return TxPool::import(_txBytes, _ik);
     }
+    std::vector<std::pair<ImportResult, h256>> batchImport(
+        std::vector<bytesConstRef> const& _txsBytes, IfDropped _ik = IfDropped::Ignore)
+    {
+        return TxPool::batchImport(_txsBytes, _ik);
+    }
+    /// runs between the verification and the insertion of a transaction
+    ImportResult verify(Transaction const& trans, IfDropped _ik = IfDropped::Ignore) override
+    {
+        ImportResult ret = TxPool::verify(trans, _ik);
+        if (m_onVerified)
+            m_onVerified();
+        return ret;
+    }
+    std::function<void()> m_onVerified;
 };
 
 class FakeBlockChain : public BlockChainInterface
@@ -132,6 +146,13 @@ public:
     }
 
     int64_t number() { return m_blockNumber - 1; }
+    int64_t durableNumber() override { return m_asyncCommit ? m_durableNumber : number(); }
+    /// the blocks up to _number reached the storage
+    void persist(int64_t _number)
+    {
+        m_durableNumber = _number;
+        m_onDurable(_number);
+    }
 
     std::pair<int64_t, int64_t> totalTransactionCount()
     {
@@ -196,6 +217,8 @@ public:
     int64_t m_blockNumber;
     int64_t m_totalTransactionCount;
     Secret m_sec;
+    bool m_asyncCommit = false;
+    int64_t m_durableNumber = 0;
 };
 class TxPoolFixture
 {
@@ -129,12 +129,181 @@ BOOST_AUTO_TEST_CASE(testImportAndSubmit)
         avoid.insert(pool_test.m_txPool->pendingList()[i].sha3());
     top_transactions = pool_test.m_txPool->topTransactions(20, avoid);
     BOOST_CHECK(top_transactions.size() == 0);
+    /// test getTransactions
+    h256s tx_hashes{pool_test.m_txPool->pendingList()[0].sha3(), sha3("missed")};
+    std::vector<size_t> missed;
+    Transactions txs = pool_test.m_txPool->getTransactions(tx_hashes, missed);
+    BOOST_CHECK(txs.size() == 2);
+    BOOST_CHECK(txs[0].sha3() == tx_hashes[0]);
+    BOOST_CHECK(missed == std::vector<size_t>{1});
     /// check getProtocol id
     BOOST_CHECK(pool_test.m_txPool->getProtocolId() == dev::eth::ProtocolID::TxPool);
     BOOST_CHECK(pool_test.m_txPool->maxBlockLimit() == 1000);
     pool_test.m_txPool->setMaxBlockLimit(100);
     BOOST_CHECK(pool_test.m_txPool->maxBlockLimit() == 100);
 }
+
+BOOST_AUTO_TEST_CASE(testBatchImport)
+{
+    TxPoolFixture pool_test(5, 5);
+    Transactions transaction_vec =
+        pool_test.m_blockChain->getBlockByHash(pool_test.m_blockChain->numberHash(0))
+            ->transactions();
+    std::vector<bytes> txs_data;
+    for (size_t i = 0; i < transaction_vec.size(); i++)
+    {
+        auto tx = transaction_vec[i];
+        tx.setNonce(tx.nonce() + u256(i) + u256(1));
+        tx.setBlockLimit(pool_test.m_blockChain->number() + u256(1));
+        Signature sig = sign(pool_test.m_blockChain->m_sec, tx.sha3(WithoutSignature));
+        tx.updateSignature(SignatureStruct(sig));
+        bytes trans_bytes;
+        tx.encode(trans_bytes);
+        txs_data.push_back(trans_bytes);
+    }
+    /// the last one is a duplicate of the first one, and one is malformed
+    txs_data.push_back(txs_data[0]);
+    txs_data.push_back(bytes{0x01, 0x02});
+    std::vector<bytesConstRef> txs_bytes;
+    for (auto const& data : txs_data)
+        txs_bytes.push_back(ref(data));
+
+    auto results = pool_test.m_txPool->batchImport(txs_bytes);
+    BOOST_CHECK(results.size() == txs_bytes.size());
+    for (size_t i = 0; i < transaction_vec.size(); i++)
+    {
+        BOOST_CHECK(results[i].first == ImportResult::Success);
+        BOOST_CHECK(results[i].second == sha3(txs_bytes[i]));
+    }
+    BOOST_CHECK(results[transaction_vec.size()].first == ImportResult::AlreadyKnown);
+    BOOST_CHECK(results[transaction_vec.size() + 1].first == ImportResult::Malformed);
+    BOOST_CHECK(pool_test.m_txPool->pendingSize() == transaction_vec.size());
+
+    TxPoolStatus status = pool_test.m_txPool->status();
+    BOOST_CHECK(status.imported == transaction_vec.size());
+    BOOST_CHECK(status.rejected == 2);
+    BOOST_CHECK(status.verifying == 0);
+}
+
+BOOST_AUTO_TEST_CASE(testCursorAndEviction)
+{
+    TxPoolFixture pool_test(5, 5);
+    Transactions transaction_vec =
+        pool_test.m_blockChain->getBlockByHash(pool_test.m_blockChain->numberHash(0))
+            ->transactions();
+    for (size_t i = 0; i < transaction_vec.size(); i++)
+    {
+        auto tx = transaction_vec[i];
+        tx.setNonce(tx.nonce() + u256(i) + u256(1));
+        /// the first two expire when the next block is committed
+        tx.setBlockLimit(pool_test.m_blockChain->number() + u256(i < 2 ? 1 : 2));
+        Signature sig = sign(pool_test.m_blockChain->m_sec, tx.sha3(WithoutSignature));
+        tx.updateSignature(SignatureStruct(sig));
+        bytes trans_bytes;
+        tx.encode(trans_bytes);
+        BOOST_CHECK(pool_test.m_txPool->import(ref(trans_bytes)) == ImportResult::Success);
+    }
+    Transactions pending_list = pool_test.m_txPool->pendingList();
+
+    /// the cursor hands out every transaction once, in import order
+    uint64_t cursor = 0;
+    Transactions top_transactions = pool_test.m_txPool->topTransactions(2, cursor);
+    BOOST_CHECK(top_transactions.size() == 2);
+    BOOST_CHECK(top_transactions[0].sha3() == pending_list[0].sha3());
+    top_transactions = pool_test.m_txPool->topTransactions(20, cursor);
+    BOOST_CHECK(top_transactions.size() == 3);
+    BOOST_CHECK(top_transactions[0].sha3() == pending_list[2].sha3());
+    BOOST_CHECK(pool_test.m_txPool->topTransactions(20, cursor).size() == 0);
+
+    /// commit an empty block, the expired transactions are evicted
+    Block block;
+    pool_test.m_blockChain->commitBlock(block, nullptr);
+    BOOST_CHECK(pool_test.m_txPool->dropBlockTrans(block));
+    BOOST_CHECK(pool_test.m_txPool->pendingSize() == 3);
+    TxPoolStatus status = pool_test.m_txPool->status();
+    BOOST_CHECK(status.dropped == 2);
+    cursor = 0;
+    top_transactions = pool_test.m_txPool->topTransactions(20, cursor);
+    BOOST_CHECK(top_transactions.size() == 3);
+    BOOST_CHECK(top_transactions[0].sha3() == pending_list[2].sha3());
+}
+
+BOOST_AUTO_TEST_CASE(testCommitDuringImport)
+{
+    TxPoolFixture pool_test(5, 5);
+    auto tx = pool_test.m_blockChain->getBlockByHash(pool_test.m_blockChain->numberHash(0))
+                  ->transactions()[0];
+    tx.setNonce(tx.nonce() + u256(1));
+    /// valid when verified, expired by the block committed before it is inserted
+    tx.setBlockLimit(pool_test.m_blockChain->number() + u256(1));
+    Signature sig = sign(pool_test.m_blockChain->m_sec, tx.sha3(WithoutSignature));
+    tx.updateSignature(SignatureStruct(sig));
+    bytes trans_bytes;
+    tx.encode(trans_bytes);
+
+    bool committed = false;
+    pool_test.m_txPool->m_onVerified = [&]() {
+        if (committed)
+            return;
+        committed = true;
+        Block block;
+        pool_test.m_blockChain->commitBlock(block, nullptr);
+        pool_test.m_txPool->dropBlockTrans(block);
+    };
+    BOOST_CHECK(pool_test.m_txPool->import(ref(trans_bytes)) ==
+                ImportResult::TransactionNonceCheckFail);
+    BOOST_CHECK(pool_test.m_txPool->pendingSize() == 0);
+    uint64_t cursor = 0;
+    BOOST_CHECK(pool_test.m_txPool->topTransactions(20, cursor).size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(testCallbackAfterDurable)
+{
+    TxPoolFixture pool_test(5, 5);
+    pool_test.m_blockChain->m_asyncCommit = true;
+    pool_test.m_blockChain->m_durableNumber = pool_test.m_blockChain->number();
+    auto tx = pool_test.m_blockChain->getBlockByHash(pool_test.m_blockChain->numberHash(0))
+                  ->transactions()[0];
+    tx.setNonce(tx.nonce() + u256(1));
+    tx.setBlockLimit(pool_test.m_blockChain->number() + u256(2));
+    Signature sig = sign(pool_test.m_blockChain->m_sec, tx.sha3(WithoutSignature));
+    tx.updateSignature(SignatureStruct(sig));
+    int64_t notified = -1;
+    tx.setRpcCallback([&](LocalisedTransactionReceipt::Ptr _receipt) {
+        /// the receipt can be queried when the callback runs
+        BOOST_CHECK(_receipt->blockNumber() <= pool_test.m_blockChain->durableNumber());
+        notified = _receipt->blockNumber();
+    });
+    pool_test.m_txPool->submit(tx);
+    BOOST_CHECK(pool_test.m_txPool->pendingSize() == 1);
+
+    /// the block is committed while the previous one is still being persisted
+    Block block;
+    block.appendTransaction(tx);
+    block.appendTransactionReceipt(TransactionReceipt());
+    pool_test.m_blockChain->commitBlock(block, nullptr);
+    BOOST_CHECK(pool_test.m_txPool->dropBlockTrans(block));
+    BOOST_CHECK(pool_test.m_txPool->pendingSize() == 0);
+    BOOST_CHECK(notified == -1);
+    pool_test.m_blockChain->persist(block.blockHeader().number() - 1);
+    BOOST_CHECK(notified == -1);
+    pool_test.m_blockChain->persist(block.blockHeader().number());
+    BOOST_CHECK(notified == block.blockHeader().number());
+
+    /// blocks which are durable when they are dropped notify at once
+    notified = -1;
+    tx.setNonce(tx.nonce() + u256(1));
+    sig = sign(pool_test.m_blockChain->m_sec, tx.sha3(WithoutSignature));
+    tx.updateSignature(SignatureStruct(sig));
+    pool_test.m_txPool->submit(tx);
+    pool_test.m_blockChain->m_asyncCommit = false;
+    Block next;
+    next.appendTransaction(tx);
+    next.appendTransactionReceipt(TransactionReceipt());
+    pool_test.m_blockChain->commitBlock(next, nullptr);
+    BOOST_CHECK(pool_test.m_txPool->dropBlockTrans(next));
+    BOOST_CHECK(notified == next.blockHeader().number());
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -541,6 +541,8 @@ generate_config_ini()
     GLOBAL-PERFORMANCE_TRACKING=false
     GLOBAL-MAX_LOG_FILE_SIZE=209715200
     GLOBAL-LOG_FLUSH_THRESHOLD=100
+    ;write the log in a background thread
+    ASYNC-ENABLED=true
 
     ;log level configuration, enable(true)/disable(false) corresponding level log
     FATAL-ENABLED=true
@@ -566,15 +568,23 @@ generate_group_genesis()
     maxTransNum=1000
     ;the ttl of broadcasted pbft message
     ;maxTTL=2
+    ;broadcast the block header and transaction hashes instead of the whole block in pbft prepare
+    ;compactPrepare=false
     ;the node id of leaders
     ${node_list}
 
 [storage]
     ;storage db type, now support leveldb 
     type=${storage_type}
+    ;compare table conditions on numbers beyond int and apply limit, only for new chains
+    ;exactConditions=false
 [state]
     ;support mpt/storage
     type=${state_type}
+    ;mpt only: false commits the state once per block, receipts then carry the parent state root
+    ;intermediateRoot=true
+    ;storage only: keep contract storage slots in binary, only for new chains
+    ;binaryStorage=false
 
 ;tx gas limit
 [tx]
@@ -587,12 +597,33 @@ function generate_group_ini()
     local output="${1}"
     cat << EOF > ${output}
 ;sync period time
+;verifyThreads decode the downloaded blocks, one per CPU core by default
 [sync]
     idleWaitMs=200
+    ;verifyThreads=4
 
 ;txpool limit
 [txPool]
     limit=1000
+
+;threads of each pbft signature verify pool, one per CPU core by default,
+;nodes running several groups should split the cores between them
+[consensus]
+    ;verifyThreads=4
+
+;storage read cache size in MB, 0 disables the cache
+;asyncCommit writes committed blocks to disk in the background
+;readThreads read batch selects with the calling thread, one per CPU core minus one by default
+[storage]
+    cacheSize=256
+    asyncCommit=true
+    ;readThreads=3
+
+;execute the transactions of a block on multiple threads, requires the storage state
+;parallelThreads execute them, one per CPU core by default
+[tx]
+    enableParallel=false
+    ;parallelThreads=4
 EOF
 }
 
@@ -65,12 +65,33 @@ function generate_group_ini()
     local output="${1}"
     cat << EOF > ${output}
 ;sync period time
+;verifyThreads decode the downloaded blocks, one per CPU core by default
 [sync]
     idleWaitMs=200
+    ;verifyThreads=4
 
 ;txpool limit
 [txPool]
     limit=1000
+
+;threads of each pbft signature verify pool, one per CPU core by default,
+;nodes running several groups should split the cores between them
+[consensus]
+    ;verifyThreads=4
+
+;storage read cache size in MB, 0 disables the cache
+;asyncCommit writes committed blocks to disk in the background
+;readThreads read batch selects with the calling thread, one per CPU core minus one by default
+[storage]
+    cacheSize=256
+    asyncCommit=true
+    ;readThreads=3
+
+;execute the transactions of a block on multiple threads, requires the storage state
+;parallelThreads execute them, one per CPU core by default
+[tx]
+    enableParallel=false
+    ;parallelThreads=4
 EOF
 }
 